@@ -31,70 +31,143 @@ inline uint16_t swapcolor(uint16_t x) {
   return (x << 11) | (x & 0x07E0) | (x >> 11);
 }
 
-#if defined (SPI_HAS_TRANSACTION)
-  static SPISettings mySPISettings;
-#elif defined (__AVR__) || defined(CORE_TEENSY)
-  static uint8_t SPCRbackup;
-  static uint8_t mySPCR;
+#if defined(ST7735_PROTOCOL_STATS)
+  #define ST7735_STAT(field, n) (_stats.field += (n))
+#else
+  #define ST7735_STAT(field, n)
 #endif
 
-// Constructor when using hardware SPI.  Faster, but must use SPI pins
-// specific to each board type (e.g. 11,13 for Uno, 51,52 for Mega, etc.)
-Adafruit_ST7735::Adafruit_ST7735(int8_t cs, int8_t dc, int8_t rst) 
-  : Adafruit_GFX(ST7735_TFTWIDTH_128, ST7735_TFTHEIGHT_160) {
+// Member setup shared by the constructors.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::setup(int8_t cs, int8_t dc, int8_t rst) {
   _cs   = cs;
   _dc   = dc;
   _rst  = rst;
-  hwSPI = true;
-  _sid  = _sclk = -1;
+  _async = false;
+  _backend = NULL;
+  _winValid = false;
+  _colorMode = COLOR_565;
+  _hasPend444 = false;
+  _madctl = _drawMadctl = 0;
+  _spiDepth = 0;
+  _scrollHeight = 0;
+  setClip(0, HEIGHT);
+  setAAColors(ST7735_WHITE, ST7735_BLACK);
+  _extFont = NULL;
+  _textEndX = _textEndY = SHRT_MIN;
+#if defined(ST7735_PROTOCOL_STATS)
+  resetStats();
+#endif
+}
+
+template<class Transport>
+inline void Adafruit_ST7735T<Transport>::spiwrite(uint8_t c) 
+{
+	ST7735_STAT(bytes, 1);
+	_bus.write(c);
 }
 
-inline void Adafruit_ST7735::spiwrite(uint8_t c) 
+// Buffer variant of spiwrite().  Some transports overwrite the buffer
+// with whatever comes back on MISO, so callers must refill it between calls.
+template<class Transport>
+inline void Adafruit_ST7735T<Transport>::spiwriteBuf(uint8_t *buf, uint16_t n)
 {
-	#if defined (SPI_HAS_TRANSACTION)
-		  SPI.transfer(c);
-	#elif defined (__AVR__) || defined(CORE_TEENSY)
-		  SPCRbackup = SPCR;
-		  SPCR = mySPCR;
-		  SPI.transfer(c);
-		  SPCR = SPCRbackup;
-	#elif defined (__arm__)
-		  SPI.setClockDivider(21); //4MHz
-		  SPI.setDataMode(SPI_MODE0);
-		  SPI.transfer(c);
-	#endif
+	ST7735_STAT(bytes, n);
+	_bus.writeBuf(buf, n);
 }
 
+// Start/end of a bus transaction: the transport is configured here,
+// not per byte.  Transactions nest, only the outermost pair touches the
+// bus, so draws inside startWrite()/endWrite() share one.
+template<class Transport>
+inline void Adafruit_ST7735T<Transport>::beginSPI(void)
+{
+	if(_spiDepth++) return;
+	_bus.begin();
+	CS_LOW();
+}
 
-void Adafruit_ST7735::writecommand(uint8_t c) {
-	#if defined (SPI_HAS_TRANSACTION)
-	//SPI.beginTransaction(mySPISettings);
-	#endif
-	  DC_LOW();
-	  CS_LOW();
+template<class Transport>
+inline void Adafruit_ST7735T<Transport>::endSPI(void)
+{
+	if(--_spiDepth) return;
+	CS_HIGH();
+	_bus.end();
+}
+
+/******** software SPI **********/
+
+void ST7735_SwSPI::init(void)
+{
+	pinMode(_sclk, OUTPUT);
+	pinMode(_sid , OUTPUT);
+#if defined(USE_FAST_IO)
+	clkport     = portOutputRegister(digitalPinToPort(_sclk));
+	dataport    = portOutputRegister(digitalPinToPort(_sid));
+	clkpinmask  = digitalPinToBitMask(_sclk);
+	datapinmask = digitalPinToBitMask(_sid);
+	*clkport   &= ~clkpinmask;
+	*dataport  &= ~datapinmask;
+#else
+	digitalWrite(_sclk, LOW);
+	digitalWrite(_sid, LOW);
+#endif
+}
+
+// Same colour n times.  Bit i of the toggle mask is set when bit i differs
+// from the bit clocked just before it (bit i+1, or bit 0 of the previous
+// pixel for the MSB), so equal neighbouring bits only cost a clock pulse.
+// Solid black and white never touch the data line at all.
+void ST7735_SwSPI::writeRepeat16(uint16_t c, uint32_t n)
+{
+#if defined(USE_FAST_IO)
+	if(!n) return;
+	uint16_t t = c ^ ((c >> 1) | (c << 15));
+	if(c & 1) *dataport |= datapinmask; else *dataport &= ~datapinmask;
+	while(n--) {
+		rbit(t & 0x8000); rbit(t & 0x4000); rbit(t & 0x2000); rbit(t & 0x1000);
+		rbit(t & 0x0800); rbit(t & 0x0400); rbit(t & 0x0200); rbit(t & 0x0100);
+		rbit(t & 0x0080); rbit(t & 0x0040); rbit(t & 0x0020); rbit(t & 0x0010);
+		rbit(t & 0x0008); rbit(t & 0x0004); rbit(t & 0x0002); rbit(t & 0x0001);
+	}
+#else
+	uint8_t hi = c >> 8, lo = c;
+	while(n--) {
+		write(hi);
+		write(lo);
+	}
+#endif
+}
 
+template<class Transport>
+void Adafruit_ST7735T<Transport>::writecommand(uint8_t c) {
+	  beginSPI();
+	  endPixels();
+	  DC_LOW();
 	  spiwrite(c);
+	  endSPI();
+}
 
-	  CS_HIGH();
-	#if defined (SPI_HAS_TRANSACTION)
-	//SPI.endTransaction();
-	#endif
+
+// Command plus its arguments in a single CS frame.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::writecommand(uint8_t c, const uint8_t *args, uint8_t n) {
+	  beginSPI();
+	  endPixels();
+	  DC_LOW();
+	  spiwrite(c);
+	  DC_HIGH();
+	  while(n--) spiwrite(*args++);
+	  endSPI();
 }
 
 
-void Adafruit_ST7735::writedata(uint8_t c) {
-	#if defined (SPI_HAS_TRANSACTION)
-	//SPI.beginTransaction(mySPISettings);
-	#endif
+template<class Transport>
+void Adafruit_ST7735T<Transport>::writedata(uint8_t c) {
+	  beginSPI();
 	  DC_HIGH();
-	  CS_LOW();
-		
 	  spiwrite(c);
-
-	  CS_HIGH();
-	#if defined (SPI_HAS_TRANSACTION)
-	//SPI.endTransaction();
-	#endif
+	  endSPI();
 }
 
 // Rather than a bazillion writecommand() and writedata() calls, screen
@@ -198,19 +271,27 @@ static const uint8_t PROGMEM
 
 // Companion code to the above tables.  Reads and issues
 // a series of LCD commands stored in PROGMEM byte array.
-void Adafruit_ST7735::commandList(const uint8_t *addr) {
+// CS is held for the whole list, DC only flips between command and args.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::commandList(const uint8_t *addr) {
 
   uint8_t  numCommands, numArgs;
   uint16_t ms;
+#if defined(ST7735_PROTOCOL_STATS)
+  ST7735_Stats before = _stats;
+#endif
 
+  beginSPI();
   numCommands = pgm_read_byte(addr++);   // Number of commands to follow
   while(numCommands--) {                 // For each command...
-    writecommand(pgm_read_byte(addr++)); //   Read, issue command
+    DC_LOW();
+    spiwrite(pgm_read_byte(addr++));     //   Read, issue command
+    DC_HIGH();
     numArgs  = pgm_read_byte(addr++);    //   Number of args to follow
     ms       = numArgs & DELAY;          //   If hibit set, delay follows args
     numArgs &= ~DELAY;                   //   Mask out delay bit
     while(numArgs--) {                   //   For each argument...
-      writedata(pgm_read_byte(addr++));  //     Read, issue argument
+      spiwrite(pgm_read_byte(addr++));   //     Read, issue argument
     }
 
     if(ms) {
@@ -219,12 +300,22 @@ void Adafruit_ST7735::commandList(const uint8_t *addr) {
       delay(ms);
     }
   }
+  endSPI();
+  _winValid = false; // lists may set CASET/RASET behind our back
+
+#if defined(ST7735_PROTOCOL_STATS)
+  uint32_t sent = _stats.bytes - before.bytes;
+  statSaved(before, sent*2, sent);
+#endif
 }
 
 
 // Initialization code common to both 'B' and 'R' type displays
-void Adafruit_ST7735::commonInit(const uint8_t *cmdList) {
+template<class Transport>
+void Adafruit_ST7735T<Transport>::commonInit(const uint8_t *cmdList) {
   ystart = xstart = colstart  = rowstart = 0; // May be overridden in init func
+  _colorMode = COLOR_565; // init tables set COLMOD to 16-bit
+  _hasPend444 = false;
 
   pinMode(_dc, OUTPUT);
   pinMode(_cs, OUTPUT);
@@ -236,11 +327,7 @@ void Adafruit_ST7735::commonInit(const uint8_t *cmdList) {
   dcpinmask = digitalPinToBitMask(_dc);
 #endif
 
-#if defined (SPI_HAS_TRANSACTION)
-    SPI.begin();
-    mySPISettings = SPISettings(16000000, MSBFIRST, SPI_MODE0);
-
-#endif
+  _bus.init();
 
   // toggle RST low to reset; CS low so it'll listen to us
   CS_LOW();
@@ -254,15 +341,15 @@ void Adafruit_ST7735::commonInit(const uint8_t *cmdList) {
     delay(500);
   }
 
+  CS_HIGH();
+
   if(cmdList) commandList(cmdList);
-  
-  //test
-  SPI.beginTransaction(mySPISettings);
 }
 
 
 // Initialization for ST7735R screens (green or red tabs)
-void Adafruit_ST7735::initR(uint8_t options) {
+template<class Transport>
+void Adafruit_ST7735T<Transport>::initR(uint8_t options) {
 	commonInit(Rcmd1);
 
 	_height = ST7735_TFTHEIGHT_128;
@@ -276,109 +363,520 @@ void Adafruit_ST7735::initR(uint8_t options) {
 }
 
 
-void Adafruit_ST7735::setAddrWindow(uint8_t x0, uint8_t y0, uint8_t x1,
+template<class Transport>
+void Adafruit_ST7735T<Transport>::setAddrWindow(uint8_t x0, uint8_t y0, uint8_t x1,
+ uint8_t y1) {
+#if defined(ST7735_PROTOCOL_STATS)
+  ST7735_Stats before = _stats;
+#endif
+
+  beginSPI();
+  writeAddrWindow(x0, y0, x1, y1);
+  endSPI();
+
+#if defined(ST7735_PROTOCOL_STATS)
+  statSaved(before, 22, 11); // 11 single-byte writes before the cache
+#endif
+}
+
+// CASET/RASET/RAMWR with CS already low.  The controller keeps its column
+// and row windows between writes, so either one that is unchanged is
+// skipped; RAMWR always goes out since it resets the write pointer.
+// Leaves DC high, ready for pixel data.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::writeAddrWindow(uint8_t x0, uint8_t y0, uint8_t x1,
  uint8_t y1) {
 
-  writecommand(ST7735_CASET); // Column addr set
-  writedata(0x00);
-  writedata(x0+xstart);     // XSTART 
-  writedata(0x00);
-  writedata(x1+xstart);     // XEND
+  endPixels();
+
+  x0 += xstart; x1 += xstart;
+  y0 += ystart; y1 += ystart;
+
+  if(!_winValid || x0 != _winX0 || x1 != _winX1) {
+    DC_LOW();
+    spiwrite(ST7735_CASET); // Column addr set
+    DC_HIGH();
+    spiwrite(0x00);
+    spiwrite(x0);           // XSTART
+    spiwrite(0x00);
+    spiwrite(x1);           // XEND
+    _winX0 = x0; _winX1 = x1;
+  } else {
+    ST7735_STAT(bytesSaved, 5);
+  }
 
-  writecommand(ST7735_RASET); // Row addr set
-  writedata(0x00);
-  writedata(y0+ystart);     // YSTART
-  writedata(0x00);
-  writedata(y1+ystart);     // YEND
+  if(!_winValid || y0 != _winY0 || y1 != _winY1) {
+    DC_LOW();
+    spiwrite(ST7735_RASET); // Row addr set
+    DC_HIGH();
+    spiwrite(0x00);
+    spiwrite(y0);           // YSTART
+    spiwrite(0x00);
+    spiwrite(y1);           // YEND
+    _winY0 = y0; _winY1 = y1;
+  } else {
+    ST7735_STAT(bytesSaved, 5);
+  }
+  _winValid = true;
 
-  writecommand(ST7735_RAMWR); // write to RAM
+  DC_LOW();
+  spiwrite(ST7735_RAMWR);   // write to RAM
+  DC_HIGH();
 }
 
+#if defined(ST7735_PROTOCOL_STATS)
+// Credit the difference between what the old one-write-per-byte framing
+// would have cost and what was actually sent since 'before'.
+// bytesSaved is counted where the skip happens.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::statSaved(const ST7735_Stats &before, uint16_t cs, uint16_t dc)
+{
+  _stats.csSaved += cs - (_stats.csToggles - before.csToggles);
+  _stats.dcSaved += dc - (_stats.dcToggles - before.dcToggles);
+}
+#endif
 
-void Adafruit_ST7735::pushColor(uint16_t color) {
-	#if defined (SPI_HAS_TRANSACTION)
-	//SPI.beginTransaction(mySPISettings);
-	#endif
 
+template<class Transport>
+void Adafruit_ST7735T<Transport>::pushColor(uint16_t color) {
+	  beginSPI();
 	  DC_HIGH();
-	  CS_LOW();
-	  spiwrite(color >> 8);
-	  spiwrite(color);
-	  CS_HIGH();
-
-	#if defined (SPI_HAS_TRANSACTION)
-	//SPI.endTransaction();
-	#endif
+	  if(_colorMode == COLOR_444) {
+	    // a pixel left unpaired is padded by endDraw() or the next command
+	    uint16_t c = to444(color);
+	    push444(&c, 1);
+	  } else {
+	    spiwrite(color >> 8);
+	    spiwrite(color);
+	  }
+	  endSPI();
 }
 
-void Adafruit_ST7735::drawPixel(int16_t x, int16_t y, uint16_t color) {
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawPixel(int16_t x, int16_t y, uint16_t color) {
+
+  if((x < _clipX0) || (x >= _clipX1) || (y < _clipY0) || (y >= _clipY1)) return;
 
   uint8_t hi = color >> 8, lo = color;
-  startDraw(x,y,x+1,y+1);
+  startDraw(x,y,x,y);
   drawFastPixel(hi,lo);
   endDraw();
 }
-//REPLACE THESE WITH writePixel/startWrite/endWrite, once all other functions are modified to take start/endwrite into account.
-void Adafruit_ST7735::drawFastPixel(uint8_t hi_c,uint8_t lo_c)
+
+// Adafruit_GFX write API.  GFX wraps each primitive (lines, circles,
+// rects, ...) in startWrite()/endWrite(), so with the nesting in
+// beginSPI() the whole primitive is one bus transaction and each pixel
+// or span only costs its window setup.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::startWrite(void)
+{
+	waitIdle();
+	beginSPI();
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::endWrite(void)
+{
+	endDraw();
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::writePixel(int16_t x, int16_t y, uint16_t color)
+{
+	drawPixel(x, y, color);
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+	drawFastHLine(x, y, w, color);
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+	drawFastVLine(x, y, h, color);
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+	fillRect(x, y, w, h, color);
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawFastPixel(uint8_t hi_c,uint8_t lo_c)
 {
+	if(_colorMode == COLOR_444)
+	{
+		uint16_t c = to444(((uint16_t)hi_c << 8) | lo_c);
+		push444(&c, 1);
+		return;
+	}
+	if(_async)
+	{
+		lineByte(hi_c);
+		lineByte(lo_c);
+		return;
+	}
 	spiwrite(hi_c);
 	spiwrite(lo_c);
 }
 
-void Adafruit_ST7735::startDraw(int16_t x, int16_t y, int16_t w, int16_t h)
+// Bulk pixel writers.  These hand whole buffers to the SPI backend
+// instead of paying a spiwrite() call per byte.
+// The public ones take RGB565; the pushNative*() ones take pixels already
+// in the controller's current format (see setColorMode()), which is what
+// the blitters use after converting their palette once per call.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::pushColors(const uint16_t *colors, uint16_t n)
 {
-	//x, y, x+w-1, y+h-1
-  setAddrWindow(x,y,w,h); //ADDR set needs to be here, sets the area of the frame buffer to write to.
-  #if defined (SPI_HAS_TRANSACTION)
-  //SPI.beginTransaction(mySPISettings);
-  #endif
-  DC_HIGH();
-  CS_LOW();
+	if(_colorMode != COLOR_444)
+	{
+		pushNative(colors, n);
+		return;
+	}
+	uint16_t buf[ST7735_PUSH_CHUNK/2];
+	while(n)
+	{
+		uint8_t k = 0;
+		while(n && k < ST7735_PUSH_CHUNK/2)
+		{
+			buf[k++] = to444(*colors++);
+			n--;
+		}
+		push444(buf, k);
+	}
 }
 
-void Adafruit_ST7735::endDraw()
+template<class Transport>
+void Adafruit_ST7735T<Transport>::pushColorRepeat(uint16_t color, uint32_t n)
 {
-	CS_HIGH();
+	pushNativeRepeat(toNative(color), n);
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::pushNative(const uint16_t *colors, uint16_t n)
+{
+	if(_colorMode == COLOR_444)
+	{
+		push444(colors, n);
+		return;
+	}
+	if(_async)
+	{
+		while(n--)
+		{
+			uint16_t c = *colors++;
+			lineByte(c >> 8);
+			lineByte(c);
+		}
+		return;
+	}
+	uint8_t buf[ST7735_PUSH_CHUNK];
+	while(n)
+	{
+		uint8_t k = 0;
+		while(n && k < ST7735_PUSH_CHUNK)
+		{
+			uint16_t c = *colors++;
+			buf[k++] = c >> 8;
+			buf[k++] = c;
+			n--;
+		}
+		spiwriteBuf(buf, k);
+	}
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::pushNativeRepeat(uint16_t color, uint32_t n)
+{
+	if(_colorMode == COLOR_444)
+	{
+		push444Repeat(color, n);
+		return;
+	}
+	uint8_t hi = color >> 8, lo = color;
+	if(_async)
+	{
+		while(n--)
+		{
+			lineByte(hi);
+			lineByte(lo);
+		}
+		return;
+	}
+	ST7735_STAT(bytes, n*2);
+	_bus.writeRepeat16(color, n);
+}
+
+// RGB444 packs two pixels into three bytes: RRRRGGGG BBBBRRRR GGGGBBBB.
+// The window is filled row after row, so a pair may straddle two rows;
+// an unpaired pixel is carried over to the next call and padded out by
+// endDraw() if the draw ends on an odd pixel count.
+#define PACK444_CHUNK (ST7735_PUSH_CHUNK - ST7735_PUSH_CHUNK % 3)
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::push444(const uint16_t *c, uint16_t n)
+{
+	uint8_t buf[PACK444_CHUNK];
+	uint8_t k = 0;
+	if(_hasPend444 && n)
+	{
+		uint16_t b = *c++;
+		n--;
+		buf[k++] = _pend444 >> 4;
+		buf[k++] = (_pend444 << 4) | (b >> 8);
+		buf[k++] = b;
+		_hasPend444 = false;
+	}
+	while(n >= 2)
+	{
+		uint16_t a = *c++, b = *c++;
+		n -= 2;
+		buf[k++] = a >> 4;
+		buf[k++] = (a << 4) | (b >> 8);
+		buf[k++] = b;
+		if(k == PACK444_CHUNK)
+		{
+			sendBuf(buf, k);
+			k = 0;
+		}
+	}
+	if(n)
+	{
+		_pend444 = *c;
+		_hasPend444 = true;
+	}
+	if(k) sendBuf(buf, k);
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::push444Repeat(uint16_t c, uint32_t n)
+{
+	if(_hasPend444 && n)
+	{
+		uint16_t one[1] = { c };
+		push444(one, 1);
+		n--;
+	}
+	uint8_t b0 = c >> 4, b1 = (c << 4) | (c >> 8), b2 = c;
+	uint8_t buf[PACK444_CHUNK];
+	uint32_t pairs = n >> 1;
+	while(pairs)
+	{
+		uint8_t k = 0;
+		while(pairs && k < PACK444_CHUNK)
+		{
+			buf[k++] = b0;
+			buf[k++] = b1;
+			buf[k++] = b2;
+			pairs--;
+		}
+		sendBuf(buf, k);
+	}
+	if(n & 1)
+	{
+		_pend444 = c;
+		_hasPend444 = true;
+	}
+}
+
+// Pad out a dangling RGB444 pixel, the spare nibble is ignored.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::flush444(void)
+{
+	if(!_hasPend444) return;
+	uint8_t buf[2] = { (uint8_t)(_pend444 >> 4), (uint8_t)(_pend444 << 4) };
+	sendBuf(buf, 2);
+	_hasPend444 = false;
+}
+
+// Pixels still buffered must reach the controller before a command.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::endPixels(void)
+{
+	flush444();
+	if(_async)
+	{
+		flushLine();
+		waitIdle();
+	}
+}
+
+template<class Transport>
+inline void Adafruit_ST7735T<Transport>::sendBuf(uint8_t *buf, uint8_t n)
+{
+	if(_async)
+	{
+		while(n--) lineByte(*buf++);
+	}
+	else
+	{
+		spiwriteBuf(buf, n);
+	}
+}
+
+// Switch the controller between 16-bit (COLOR_565) and 12-bit (COLOR_444)
+// pixels.  Everything keeps taking RGB565 colours; in 444 mode they are
+// converted on the way out and each pixel costs 1.5 bytes on the bus.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::setColorMode(uint8_t mode)
+{
+	_colorMode = (mode == COLOR_444) ? COLOR_444 : COLOR_565;
+	writecommand(ST7735_COLMOD, &_colorMode, 1);
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::pushBytes(const uint8_t *data, uint16_t n)
+{
+	flush444(); // raw bytes start on a byte boundary
+	if(_async)
+	{
+		while(n--) lineByte(*data++);
+		return;
+	}
+	uint8_t buf[ST7735_PUSH_CHUNK];
+	while(n)
+	{
+		uint8_t k = (n < ST7735_PUSH_CHUNK) ? n : ST7735_PUSH_CHUNK;
+		memcpy(buf, data, k);
+		spiwriteBuf(buf, k);
+		data += k;
+		n -= k;
+	}
+}
 
-	#if defined (SPI_HAS_TRANSACTION)
-	//SPI.endTransaction();
-	#endif
+// Async line engine.  Two line buffers alternate: while the backend
+// sends one, the decoders fill the other, so decoding row N+1 overlaps
+// the transfer of row N.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::beginAsync(uint8_t *bufA, uint8_t *bufB, uint16_t len, ST7735_LineBackend *backend)
+{
+	waitIdle();
+	_lineBuf[0] = bufA;
+	_lineBuf[1] = bufB;
+	_lineLen  = len;
+	_lineFill = 0;
+	_lineCur  = 0;
+	_backend  = backend;
+	_async    = (bufA && bufB && len);
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::endAsync(void)
+{
+	flushLine();
+	waitIdle();
+	_async = false;
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::waitIdle(void)
+{
+	if(_backend)
+	{
+		while(_backend->busy());
+	}
+}
+
+template<class Transport>
+inline void Adafruit_ST7735T<Transport>::lineByte(uint8_t b)
+{
+	_lineBuf[_lineCur][_lineFill++] = b;
+	if(_lineFill >= _lineLen) flushLine();
+}
+
+// Hand the current line to the backend and switch to the other buffer.
+// The other buffer is only reused once its own transfer has finished.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::flushLine(void)
+{
+	if(!_async || !_lineFill) return;
+	if(_backend)
+	{
+		waitIdle();
+		_backend->transfer(_lineBuf[_lineCur], _lineFill);
+	}
+	else
+	{
+		spiwriteBuf(_lineBuf[_lineCur], _lineFill);
+	}
+	_lineCur ^= 1;
+	_lineFill = 0;
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::startDraw(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+	waitIdle();
+#if defined(ST7735_PROTOCOL_STATS)
+  ST7735_Stats before = _stats;
+#endif
+  beginSPI();
+	//x, y, x+w-1, y+h-1
+  writeAddrWindow(x,y,w,h); //ADDR set needs to be here, sets the area of the frame buffer to write to.
+  // CS stays low and DC high from the window setup straight into the pixels
+#if defined(ST7735_PROTOCOL_STATS)
+  statSaved(before, 23, 12);
+#endif
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::endDraw()
+{
+	endPixels(); //CS has to stay low until the last line is out
+	if(_drawMadctl != _madctl) //back from startOriented()
+	{
+		DC_LOW();
+		spiwrite(ST7735_MADCTL);
+		DC_HIGH();
+		spiwrite(_madctl);
+		_drawMadctl = _madctl;
+		_winValid = false;
+	}
+	endSPI();
 }
 
-void Adafruit_ST7735::drawFastBitmap(int16_t x, int16_t y,
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawFastBitmap(int16_t x, int16_t y,
   const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color,uint16_t bg) {
 
     int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
     uint8_t byte = 0;
-	// rudimentary clipping (drawChar w/big text requires this)
-	if((x >= _width) || (y >= _height)) return;
-	if((x + w - 1) >= _width)  w = _width  - x;
-	if((y + h - 1) >= _height) h = _height - y;
-	
-	uint8_t hi = color >> 8, lo = color;
-	uint8_t hi_bg = bg >> 8, lo_bg = bg;
+	int16_t sx = x, sy = y;
+	if(!clipRect(x, y, w, h)) return;
+	sx = x - sx; // source offset of the visible part
+	sy = y - sy;
 	
+	uint16_t lineBuf[ST7735_PUSH_CHUNK/2];
+	uint8_t  k = 0;
+	color = toNative(color);
+	bg    = toNative(bg);
+
     startDraw(x,y,x+w-1,y+h-1);
     for(int16_t j=0; j<h; j++, y++) {
+        const uint8_t *row = &bitmap[(j + sy) * byteWidth];
         for(int16_t i=0; i<w; i++) {
-            if(i & 7) byte <<= 1;
-            else      byte   = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-            if(byte & 0x80)
-			{
-				//if((x < 0) ||(x >= _width) || (y < 0) || (y >= _height)) return;
-				drawFastPixel(hi,lo);
-			}
-			else //Looks like we need to write a background color for FastBG, because we have a screen area that gets written to sequentially, not sure how to skip yet.
+            int16_t si = i + sx;
+            if(i && (si & 7)) byte <<= 1;
+            else      byte   = pgm_read_byte(&row[si / 8]) << (si & 7);
+			//Looks like we need to write a background color for FastBG, because we have a screen area that gets written to sequentially, not sure how to skip yet.
+			lineBuf[k++] = (byte & 0x80) ? color : bg;
+			if(k == ST7735_PUSH_CHUNK/2)
 			{
-				drawFastPixel(hi_bg,lo_bg);
+				pushNative(lineBuf, k);
+				k = 0;
 			}
         }
     }
+	if(k) pushNative(lineBuf, k);
     endDraw();
 }
 
 //Draw fast bitmap, non-transparent
-void Adafruit_ST7735::drawFastColorBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t colorIndex[], const uint16_t pal[],bool flipH, bool flipV) {
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawFastColorBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t colorIndex[], const uint16_t pal[],bool flipH, bool flipV) {
 	drawCBMPsectionRLE(x,y,w,h,colorIndex,emptyTiles,pal,w,h,0,flipH,flipV);
 }
 //FLIP image vertically, can just draw last line first, then go up
@@ -396,160 +894,645 @@ void Adafruit_ST7735::drawFastColorBitmap(int16_t x, int16_t y, int16_t w, int16
 
 //DRAW 1-bit bmp section, for use with fonts. ADAfruits GFX font routine is HUGE.
 
-//need to compact CIDX to 4bit
-void Adafruit_ST7735::drawCBMPsection(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t pal[], uint8_t imageW, uint8_t imageH, uint8_t sectionID, bool flipH, bool flipV, uint8_t bitDepth) {
-
-	// rudimentary clipping (drawChar w/big text requires this)
-	if((x >= _width) || (y >= _height)) return;
-	
-	//1-bit vars
-	int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-    uint8_t byte = 0;
-	uint16_t monoCol = pgm_read_word(&pal[0]);
-	uint16_t monoBG = pgm_read_word(&pal[1]);
-	uint8_t hi = monoCol >> 8, lo = monoCol;
-	uint8_t hi_bg = monoBG >> 8, lo_bg = monoBG;
-	uint16_t startAddr = sectionID * (w*h);
-	//end 1-bit vars
-	
-
-	//get correct address position of the tile we want
-	uint8_t line = ((sectionID * w) / imageW);
-	uint16_t iterator = ((sectionID * w) % imageW) + ((h*line)*imageW);
-	
-	//4bitvals
-	uint16_t finalColor;
-	uint8_t color;
-	
-	int itXAdder = 1;
-	int itYAdder = imageW - w;
-	
-	if (flipV)
-	{
-		itXAdder = -1;
-		itYAdder = -(imageW - w);
+//bitDepth 1: mono, pal[0] set / pal[1] clear.  4: one palette index per byte.
+//ST7735_PACKED4 and ST7735_PACKED2: packed indices, first pixel in the high
+//bits, image rows padded to a whole byte.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawCBMPsection(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t pal[], uint8_t imageW, uint8_t imageH, uint8_t sectionID, bool flipH, bool flipV, uint8_t bitDepth, bool rot90) {
 
-		iterator = w*h;//this  will only work for non tiles - imageW same as w.
-		//iterator -= h;
-	}
-	if(flipH)
+	//flips and turns are done by the controller's scan order
+	uint8_t orient = orientBits(flipH, flipV, rot90);
+	uint16_t palN[16];
+	if((bitDepth == ST7735_PACKED4) || (bitDepth == ST7735_PACKED2))
 	{
-		itXAdder = -1;
-		itYAdder = w*2;
-		iterator = w;
-		iterator -= h;
+		bitDepth &= ~ST7735_PACKED;
+		loadPalette(pal, palN, 1 << bitDepth);
+		drawSectionPacked(x, y, w, h, colorIndex, palN, imageW, sectionID, orient, bitDepth);
+		return;
 	}
-	unsigned char digit[] = {0xff, 0xc3, 0x81, 0xbd, 0xbd, 0x81, 0xc3, 0xff};
-    startDraw(x,y,x+w-1,y+h-1);
-    for(uint8_t j=0; j<h; j+=1, y++) {
-        for(uint8_t i=0; i<w; i++) {
-			switch(bitDepth)
-			{
-				case 4: 
-				color = pgm_read_byte(&colorIndex[iterator]);
-				
-				
-				//move to a var- should also do bit shifting on load.
-				finalColor = pgm_read_word(&pal[color]);
-				drawFastPixel(finalColor >> 8, finalColor);
-				break;
-				
-				case 1:
-				if((i+startAddr)& 7) byte <<= 1;
-				else      byte   = pgm_read_byte(&colorIndex[(j * byteWidth + (i+startAddr)/ 8)]);
-				if(byte & 0x80)
-				{
-					//if((x < 0) ||(x >= _width) || (y < 0) || (y >= _height)) return;
-					drawFastPixel(hi,lo);
-				}
-				else //Looks like we need to write a background color for FastBG, because we have a screen area that gets written to sequentially, not sure how to skip yet.
-				{
-					drawFastPixel(hi_bg,lo_bg);
-				}
-				break;
-				iterator +=itXAdder;
-			};
-			
-        }
-		iterator += itYAdder;
-		//iterator+= imageW - w;//}
-    }
-    endDraw();
-}
 
-void Adafruit_ST7735::drawCBMPsectionRLE(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint16_t pal[], uint8_t imageW, uint8_t imageH, uint8_t sectionID, bool flipH, bool flipV) {
+	//only the visible sw x sh part of the tile, from (si, sj), is read
+	uint8_t si, sj, sw, sh;
+	if(!clipOriented(x, y, w, h, orient, si, sj, sw, sh)) return;
 
-	// rudimentary clipping (drawChar w/big text requires this)
-	if((x >= _width) || (y >= _height)) return;
+	if(bitDepth == 1) loadPalette(pal, palN, 2); //set, clear
+	else loadPalette(pal, palN, 16);
 
-	//uint8_t palHi[palSize] = palH;
-	//uint8_t palLo[palSize] = palL;
-	uint8_t tiles =pgm_read_byte(&tileAddr[0]);
-	
-    startDraw(x,y,x+w-1,y+h-1);
+	uint16_t lineBuf[ST7735_PUSH_CHUNK/2];
+	uint8_t  k = 0;
 
-	uint8_t rLength = 0;
-	uint8_t colorID = 0;
-	//uint8_t linehi[w]; // for flip
-	//uint8_t linelo[w];
-	uint8_t lineCtr = 0;
-	uint16_t imageSz = w*h;
-	uint16_t startAddr = 0;
-	uint16_t pixelsDrawn=0;
-	if(tiles >= sectionID)
-	{
-		startAddr = pgm_read_word(&tileAddr[sectionID+1]);
-	}
-	for(uint16_t j=startAddr; pixelsDrawn<imageSz;j++)
-	{
-		uint8_t color = pgm_read_byte(&colorIndex[j]);
-		//start rle read
-		//rle_4_bit(color,rLength,colorID);
-		rLength = color & 0xF;
-		colorID = (color >> 4) & 0xF;
-		//end rle read
-		uint16_t finalColor = pgm_read_word(&pal[colorID]);
-		uint8_t hi = finalColor >> 8, lo = finalColor;
-		
-		for(uint8_t i = 0; i<rLength+1;i++)
-		{
-			/*if(flipH)
+	if(!startOriented(x, y, sw, sh, orient)) return;
+
+	if(bitDepth == 1)
+	{
+		//tiles follow each other bit by bit, rows padded to a whole byte
+		int16_t  byteWidth = (w + 7) / 8;
+		uint16_t startAddr = sectionID * (w*h) + si;
+		for(uint8_t j=0; j<sh; j++)
+		{
+			const uint8_t *row = &colorIndex[(sj + j) * byteWidth];
+			uint8_t byte = 0;
+			for(uint8_t i=0; i<sw; i++)
 			{
-				linehi[lineCtr] = hi;
-				linelo[lineCtr] = lo;
-				lineCtr++;
-				if(lineCtr >= w)
+				uint16_t bit = startAddr + i;
+				if(i && (bit & 7)) byte <<= 1;
+				else byte = pgm_read_byte(&row[bit / 8]) << (bit & 7);
+				//Looks like we need to write a background color for FastBG, because we have a screen area that gets written to sequentially, not sure how to skip yet.
+				lineBuf[k++] = (byte & 0x80) ? palN[0] : palN[1];
+				if(k == ST7735_PUSH_CHUNK/2)
 				{
-					lineCtr = 0;
-					for(uint8_t k=w;k>0;k--)
-					{
-						drawFastPixel(linehi[k], linelo[k]);
-					}
+					pushNative(lineBuf, k);
+					k = 0;
 				}
-			}*/
-			//else
-			//{
-				drawFastPixel(hi, lo);
-			//}
+			}
 		}
-		pixelsDrawn+=rLength+1;
-		//will probably need checks to see if rectFill exceeds graphic width
-		//pixels drawn var
-		
 	}
-
+	else
+	{
+		const uint8_t *src = &colorIndex[tileOffset(sectionID, w, h, imageW) + (uint16_t)sj * imageW + si];
+		for(uint8_t j=0; j<sh; j++, src += imageW)
+		{
+			for(uint8_t i=0; i<sw; i++)
+			{
+				lineBuf[k++] = palN[pgm_read_byte(&src[i])];
+				if(k == ST7735_PUSH_CHUNK/2)
+				{
+					pushNative(lineBuf, k);
+					k = 0;
+				}
+			}
+		}
+	}
+	if(k) pushNative(lineBuf, k);
     endDraw();
-	
 }
 
-//Draw Slow Color BMPs, with transparency.
-//At present im not sure its possible to draw transparent BMPs with setAddrWindow set to the size of the graphic.
-//setAddrWindow needs to be provided with data to fill the entire space, it doesnt have a 'skip pixel' byte im aware of.
-void Adafruit_ST7735::drawColorBitmap(int16_t x, int16_t y,
-  const uint8_t bitmap[], int16_t w, int16_t h, const uint8_t colorIndex[], const uint16_t pal[], uint16_t bg) {
+//4 and 2 bit packed indices into a palette already in RAM, see drawCBMPsection()
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawSectionPacked(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t *palN, uint8_t imageW, uint8_t sectionID, uint8_t orient, uint8_t bitDepth)
+{
+	uint8_t si, sj, sw, sh;
+	if(!clipOriented(x, y, w, h, orient, si, sj, sw, sh)) return;
+	if(!startOriented(x, y, sw, sh, orient)) return;
+
+	//a tile can start part way into a byte when its x is not a
+	//multiple of the pixels per byte
+	uint8_t  perByte = 8 / bitDepth;
+	uint16_t rowBytes = ((uint16_t)imageW * bitDepth + 7) / 8;
+	uint16_t px = (uint16_t)sectionID * w;
+	uint16_t tx = px % imageW + si;
+	const uint8_t *src = &colorIndex[((uint16_t)h * (px / imageW) + sj) * rowBytes + tx / perByte];
+	uint16_t lineBuf[ST7735_PUSH_CHUNK/2];
+	uint8_t  k = 0;
+	for(uint8_t j=0; j<sh; j++, src += rowBytes) pushPackedRow(src, tx % perByte, sw, bitDepth, palN, lineBuf, k);
+	if(k) pushNative(lineBuf, k);
+	endDraw();
+}
 
-    int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-    uint8_t byte = 0;
+// n packed pixels from p, the first skip pixels of *p left out, appended
+// to lineBuf at k and pushed whenever it fills up.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::pushPackedRow(const uint8_t *p, uint8_t skip, uint8_t n, uint8_t bitDepth, const uint16_t *palN, uint16_t *lineBuf, uint8_t &k)
+{
+	uint8_t perByte = 8 / bitDepth;
+	while(n)
+	{
+		uint8_t b = pgm_read_byte(p++) << (skip * bitDepth);
+		uint8_t m = perByte - skip;
+		if(m > n) m = n;
+		skip = 0;
+		n -= m;
+		if(m == perByte) //whole byte
+		{
+			if(bitDepth == 4)
+			{
+				lineBuf[k++] = palN[b >> 4];
+				lineBuf[k++] = palN[b & 0xF];
+			}
+			else
+			{
+				lineBuf[k++] = palN[b >> 6];
+				lineBuf[k++] = palN[(b >> 4) & 3];
+				lineBuf[k++] = palN[(b >> 2) & 3];
+				lineBuf[k++] = palN[b & 3];
+			}
+		}
+		else
+		{
+			while(m--)
+			{
+				lineBuf[k++] = palN[b >> (8 - bitDepth)];
+				b <<= bitDepth;
+			}
+		}
+		if(k > ST7735_PUSH_CHUNK/2 - 4)
+		{
+			pushNative(lineBuf, k);
+			k = 0;
+		}
+	}
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawCBMPsectionRLE(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint16_t pal[], uint8_t imageW, uint8_t imageH, uint8_t sectionID, bool flipH, bool flipV, bool rot90) {
+
+	uint16_t palN[16];
+	loadPalette(pal, palN, 16);
+	drawSectionRLE(x, y, w, h, colorIndex, tileAddr, NULL, palN, pal, sectionID, orientBits(flipH, flipV, rot90));
+}
+
+//Same with the palette split into low and high byte tables (16 colour
+//formats only, V3 sheets are not drawn).
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawCBMPsectionRLE(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint8_t pal_lo[], const uint8_t pal_hi[], uint8_t imageW, uint8_t imageH, uint8_t sectionID, bool flipH, bool flipV, bool rot90) {
+
+	uint16_t palN[16];
+	loadPalette(pal_lo, pal_hi, palN, 16);
+	drawSectionRLE(x, y, w, h, colorIndex, tileAddr, NULL, palN, NULL, sectionID, orientBits(flipH, flipV, rot90));
+}
+
+//RLE decode loop shared by the palette variants; palN is already in RAM
+//and in the controller's format, so a run is one lookup and a bulk fill.
+//Rows above the visible part are skipped through rowIndex (or decoded and
+//dropped without one) and the columns either side are stepped over a run
+//at a time, never pushed.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawSectionRLE(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint16_t rowIndex[], const uint16_t *palN, const uint16_t pal[], uint8_t sectionID, uint8_t orient) {
+
+	uint8_t si, sj, sw, sh;
+	if(!clipOriented(x, y, w, h, orient, si, sj, sw, sh)) return;
+
+	ST7735_RLEState s;
+	rleSeek(s, colorIndex, tileAddr, rowIndex, sectionID, sj, w, pal);
+	if((s.fmt == ST7735_RLE_V3) && !pal) return;
+	
+	//flips and turns are done by the controller's scan order, so the runs
+	//can still be pushed whole
+	if(!startOriented(x, y, sw, sh, orient)) return;
+	rlePushRect(s, palN, w, si, sw, sh);
+    endDraw();
+}
+
+// Push sh rows of columns si..si+sw-1 from a w wide RLE stream that is
+// at the start of a row.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::rlePushRect(ST7735_RLEState &s, const uint16_t *palN, uint8_t w, uint8_t si, uint8_t sw, uint8_t sh)
+{
+	if(sw == w)
+	{
+		rlePush(s, palN, (uint16_t)w * sh);
+		return;
+	}
+	uint8_t b = w - si - sw;
+	for(uint8_t j = 0; j < sh; j++)
+	{
+		if(si) rleDecode(s, NULL, NULL, si);
+		rlePush(s, palN, sw);
+		if(b && (j < sh - 1)) rleDecode(s, NULL, NULL, b);
+	}
+}
+
+// Draw tile 'tile' of an asset sheet, in whatever format the asset
+// compiler picked for it.  Clipped, and flipped/turned like the section
+// blitters.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawAsset(int16_t x, int16_t y, const ST7735_Asset &a, uint8_t tile, bool flipH, bool flipV, bool rot90)
+{
+	if(tile >= a.count) return;
+	uint8_t format = pgm_read_byte(&a.format[tile]);
+	const uint8_t *p = &a.data[pgm_read_word(&a.offset[tile])];
+	if(!(format & ST7735_ASSET_RLE))
+	{
+		drawCBMPsection(x, y, a.tileW, a.tileH, p, a.pal, a.tileW, a.tileH, 0, flipH, flipV, format, rot90);
+		return;
+	}
+
+	uint8_t orient = orientBits(flipH, flipV, rot90);
+	uint8_t si, sj, sw, sh;
+	if(!clipOriented(x, y, a.tileW, a.tileH, orient, si, sj, sw, sh)) return;
+
+	uint16_t palN[16];
+	loadPalette(a.pal, palN, 16);
+	ST7735_RLEState s;
+	rleStart(s, p, format & ~ST7735_ASSET_RLE, a.pal);
+	rleDecode(s, NULL, NULL, (uint16_t)sj * a.tileW);
+
+	if(!startOriented(x, y, sw, sh, orient)) return;
+	rlePushRect(s, palN, a.tileW, si, sw, sh);
+	endDraw();
+}
+
+// Visible part of a w x h source drawn at x, y with orientation 'orient'
+// (see startOriented()).  Moves x, y to the top left of what is left on
+// screen and returns the source rectangle that lands there.
+template<class Transport>
+boolean Adafruit_ST7735T<Transport>::clipOriented(int16_t &x, int16_t &y, uint8_t w, uint8_t h, uint8_t orient, uint8_t &si, uint8_t &sj, uint8_t &sw, uint8_t &sh)
+{
+	boolean turn = orient & ST7735_ROTATE_90;
+	int16_t fx = x, fy = y, fw = turn ? h : w, fh = turn ? w : h;
+	if(!clipRect(fx, fy, fw, fh)) return false;
+	uint8_t u0 = fx - x, u1 = u0 + fw; //visible footprint columns
+	uint8_t v0 = fy - y, v1 = v0 + fh; //and rows
+	x = fx;
+	y = fy;
+	if(!turn)
+	{
+		si = (orient & ST7735_FLIP_H) ? w - u1 : u0;
+		sj = (orient & ST7735_FLIP_V) ? h - v1 : v0;
+		sw = fw;
+		sh = fh;
+	}
+	else //source columns run down the screen, source rows right to left
+	{
+		si = (orient & ST7735_FLIP_H) ? w - v1 : v0;
+		sj = (orient & ST7735_FLIP_V) ? u0 : h - u1;
+		sw = fh;
+		sh = fw;
+	}
+	return true;
+}
+
+// Start decoding RLE tile 'tile' of a tileAddr-indexed sheet.  A tile past
+// the end of the table decodes from the start of the data.  pal is only
+// needed for V3 sheets.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::rleBegin(ST7735_RLEState &s, const uint8_t colorIndex[], const uint16_t tileAddr[], uint8_t tile, const uint16_t pal[])
+{
+	uint16_t head = pgm_read_word(&tileAddr[0]);
+	rleStart(s, (tile < (head & 0xFF)) ? &colorIndex[pgm_read_word(&tileAddr[tile+1])] : colorIndex, head >> 8, pal);
+}
+
+// Start decoding an RLE stream at p, in format fmt (ST7735_RLE_V1..V3).
+template<class Transport>
+void Adafruit_ST7735T<Transport>::rleStart(ST7735_RLEState &s, const uint8_t *p, uint8_t fmt, const uint16_t pal[])
+{
+	s.p = p;
+	s.pal = pal;
+	s.fmt = fmt ? fmt : ST7735_RLE_V1;
+	s.left = 0;
+	s.lit = 0;
+}
+
+// Start decoding tile 'tile' at the first pixel of row 'row', jumping to
+// the nearest indexed row above it when a rowIndex is given and stepping
+// over the rest without pushing anything.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::rleSeek(ST7735_RLEState &s, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint16_t rowIndex[], uint8_t tile, uint8_t row, uint8_t w, const uint16_t pal[])
+{
+	rleBegin(s, colorIndex, tileAddr, tile, pal);
+	uint16_t skip = (uint16_t)row * w;
+	if(rowIndex)
+	{
+		uint8_t n = pgm_read_word(&rowIndex[0]);
+		uint8_t e = pgm_read_word(&rowIndex[1]);
+		uint8_t k = n ? row / n : 0;
+		if(k > e) k = e;
+		if(k && (tile < (pgm_read_word(&tileAddr[0]) & 0xFF)))
+		{
+			const uint16_t *ent = &rowIndex[2 + ((uint16_t)tile * e + k - 1) * 2];
+			s.p += pgm_read_word(&ent[0]);
+			skip = (uint16_t)(row - k * n) * w + pgm_read_word(&ent[1]);
+		}
+	}
+	rleDecode(s, NULL, NULL, skip);
+}
+
+// RLE section with a row index, so a draw clipped at the top starts
+// decoding near its first visible row.  rowIndex may be NULL.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawCBMPsectionRLE(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint16_t rowIndex[], const uint16_t pal[], uint8_t sectionID)
+{
+	uint16_t palN[16];
+	loadPalette(pal, palN, 16);
+	drawSectionRLE(x, y, w, h, colorIndex, tileAddr, rowIndex, palN, pal, sectionID, 0);
+}
+
+// Read the next packet header.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::rleNext(ST7735_RLEState &s)
+{
+	uint8_t b = pgm_read_byte(s.p++);
+	s.lit = 0;
+	switch(s.fmt)
+	{
+		case ST7735_RLE_V2:
+		if(b & 0x80)
+		{
+			s.left = (b & 0x7F) + 1;
+			s.lit  = 1;
+		}
+		else
+		{
+			s.color = b & 0xF;
+			b >>= 4;
+			s.left = (b == 7) ? 8 + pgm_read_byte(s.p++) : b + 1;
+		}
+		break;
+
+		case ST7735_RLE_V3:
+		if(b & 0x80)
+		{
+			s.left  = (b & 0x7F) + 1;
+			s.color = pgm_read_byte(s.p++);
+		}
+		else
+		{
+			s.left = b + 1;
+			s.lit  = 1;
+		}
+		break;
+
+		default:
+		s.color = b >> 4;
+		s.left  = (b & 0xF) + 1;
+	}
+}
+
+// Next index of a literal packet.
+template<class Transport>
+inline uint8_t Adafruit_ST7735T<Transport>::rleLiteral(ST7735_RLEState &s)
+{
+	if(s.fmt == ST7735_RLE_V3) return pgm_read_byte(s.p++);
+	if(s.lit == 1)
+	{
+		s.cur = pgm_read_byte(s.p++);
+		s.lit = 2;
+		return s.cur >> 4;
+	}
+	s.lit = 1;
+	return s.cur & 0xF;
+}
+
+// Push the next n pixels of an RLE stream; runs go out as one repeat fill.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::rlePush(ST7735_RLEState &s, const uint16_t *palN, uint16_t n)
+{
+	boolean big = (s.fmt == ST7735_RLE_V3);
+	while(n)
+	{
+		if(!s.left) rleNext(s);
+		uint16_t k = (s.left < n) ? s.left : n;
+		s.left -= k;
+		n -= k;
+		if(!s.lit)
+		{
+			pushNativeRepeat(big ? toNative(pgm_read_word(&s.pal[s.color])) : palN[s.color], k);
+			continue;
+		}
+		uint16_t lineBuf[ST7735_PUSH_CHUNK/2];
+		uint8_t  m = 0;
+		while(k--)
+		{
+			uint8_t c = rleLiteral(s);
+			lineBuf[m++] = big ? toNative(pgm_read_word(&s.pal[c])) : palN[c];
+			if(m == ST7735_PUSH_CHUNK/2)
+			{
+				pushNative(lineBuf, m);
+				m = 0;
+			}
+		}
+		if(m) pushNative(lineBuf, m);
+	}
+}
+
+// Decode the next n pixels of an RLE stream into out (RGB565, from a RAM
+// palette, or the PROGMEM one given to rleBegin() for V3), or just step
+// over them when out is NULL.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::rleDecode(ST7735_RLEState &s, const uint16_t *pal, uint16_t *out, uint16_t n)
+{
+	boolean big = (s.fmt == ST7735_RLE_V3);
+	while(n)
+	{
+		if(!s.left) rleNext(s);
+		uint16_t k = (s.left < n) ? s.left : n;
+		s.left -= k;
+		n -= k;
+		if(!s.lit)
+		{
+			if(out)
+			{
+				uint16_t c = big ? pgm_read_word(&s.pal[s.color]) : pal[s.color];
+				while(k--) *out++ = c;
+			}
+		}
+		else if(!out && big)
+		{
+			s.p += k;
+		}
+		else
+		{
+			while(k--)
+			{
+				uint8_t c = rleLiteral(s);
+				if(out) *out++ = big ? pgm_read_word(&s.pal[c]) : pal[c];
+			}
+		}
+	}
+}
+
+// Offset of tile 'tile' in a byte-per-pixel sheet imageW pixels wide.
+template<class Transport>
+uint16_t Adafruit_ST7735T<Transport>::tileOffset(uint8_t tile, uint8_t w, uint8_t h, uint8_t imageW)
+{
+	uint16_t px = (uint16_t)tile * w;
+	return (px % imageW) + (uint16_t)h * (px / imageW) * imageW;
+}
+
+template<class Transport>
+boolean Adafruit_ST7735T<Transport>::stripFits(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+	return (x >= _clipX0) && (y >= _clipY0) && (x + w <= _clipX1) && (y + h <= _clipY1);
+}
+
+// Draw count tiles side by side, streaming one scanline across all of
+// them at a time, in one address window per ST7735_MAX_TILE_RUN tiles.
+// For the 16 colour byte-per-pixel sheets drawCBMPsection() reads with
+// bitDepth 4.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawTiles(int16_t x, int16_t y, uint8_t tw, uint8_t th, const uint8_t tiles[], uint8_t count, const uint8_t colorIndex[], const uint16_t pal[], uint8_t imageW)
+{
+	if(!count) return;
+	if(!stripFits(x, y, tw * count, th))
+	{
+		for(uint8_t t = 0; t < count; t++)
+			drawCBMPsection(x + t*tw, y, tw, th, colorIndex, pal, imageW, 0, tiles[t], false, false, 4);
+		return;
+	}
+
+	uint16_t palN[16];
+	loadPalette(pal, palN, 16);
+	uint16_t addr[ST7735_MAX_TILE_RUN];
+	uint16_t lineBuf[ST7735_PUSH_CHUNK/2];
+	while(count)
+	{
+		uint8_t n = (count < ST7735_MAX_TILE_RUN) ? count : ST7735_MAX_TILE_RUN;
+		for(uint8_t t = 0; t < n; t++) addr[t] = tileOffset(tiles[t], tw, th, imageW);
+
+		uint8_t k = 0;
+		startDraw(x, y, x + tw*n - 1, y + th - 1);
+		for(uint8_t j = 0; j < th; j++)
+		{
+			for(uint8_t t = 0; t < n; t++)
+			{
+				const uint8_t *src = &colorIndex[addr[t] + (uint16_t)j * imageW];
+				for(uint8_t i = 0; i < tw; i++)
+				{
+					lineBuf[k++] = palN[pgm_read_byte(&src[i])];
+					if(k == ST7735_PUSH_CHUNK/2)
+					{
+						pushNative(lineBuf, k);
+						k = 0;
+					}
+				}
+			}
+		}
+		if(k) pushNative(lineBuf, k);
+		endDraw();
+
+		tiles += n;
+		count -= n;
+		x += tw * n;
+	}
+}
+
+// RLE version of drawTiles().  Every tile keeps its own decoder state so
+// its stream can be picked up again on the next scanline.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawTilesRLE(int16_t x, int16_t y, uint8_t tw, uint8_t th, const uint8_t tiles[], uint8_t count, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint16_t pal[])
+{
+	if(!count) return;
+	if(!stripFits(x, y, tw * count, th))
+	{
+		for(uint8_t t = 0; t < count; t++)
+			drawCBMPsectionRLE(x + t*tw, y, tw, th, colorIndex, tileAddr, pal, tw, th, tiles[t], false, false);
+		return;
+	}
+
+	uint16_t palN[16];
+	loadPalette(pal, palN, 16);
+	ST7735_RLEState st[ST7735_MAX_TILE_RUN];
+	while(count)
+	{
+		uint8_t n = (count < ST7735_MAX_TILE_RUN) ? count : ST7735_MAX_TILE_RUN;
+		for(uint8_t t = 0; t < n; t++) rleBegin(st[t], colorIndex, tileAddr, tiles[t], pal);
+
+		startDraw(x, y, x + tw*n - 1, y + th - 1);
+		for(uint8_t j = 0; j < th; j++)
+		{
+			for(uint8_t t = 0; t < n; t++) rlePush(st[t], palN, tw);
+		}
+		endDraw();
+
+		tiles += n;
+		count -= n;
+		x += tw * n;
+	}
+}
+
+// Opaque-run span table for a 1bpp mask (rows padded to whole bytes,
+// set bit = opaque).  Per row: a run count, then (x, length) per run.
+// Pass out = NULL to get the size needed; returns 0 if out is too small.
+template<class Transport>
+uint16_t Adafruit_ST7735T<Transport>::buildSpans(const uint8_t mask[], uint8_t w, uint8_t h, uint8_t *out, uint16_t outSize)
+{
+	uint8_t  byteWidth = (w + 7) / 8;
+	uint16_t n = 0;
+	for(uint8_t j = 0; j < h; j++)
+	{
+		const uint8_t *row = &mask[j * byteWidth];
+		uint16_t countAt = n++;
+		uint8_t  runs = 0;
+		uint8_t  i = 0;
+		while(i < w)
+		{
+			while((i < w) && !(pgm_read_byte(&row[i / 8]) & (0x80 >> (i & 7)))) i++;
+			if(i >= w) break;
+			uint8_t start = i;
+			while((i < w) && (pgm_read_byte(&row[i / 8]) & (0x80 >> (i & 7)))) i++;
+			if(out)
+			{
+				if(n + 2 > outSize) return 0;
+				out[n]   = start;
+				out[n+1] = i - start;
+			}
+			n += 2;
+			runs++;
+		}
+		if(out)
+		{
+			if(countAt >= outSize) return 0;
+			out[countAt] = runs;
+		}
+	}
+	return n;
+}
+
+// Transparent draw from a span table: every opaque run gets the smallest
+// window setup the cache allows (normally CASET only, RASET once per row)
+// followed by a bulk push, all in one bus transaction.  colorIndex is one
+// byte per pixel into a 16 entry pal.  Set spansInProgmem for tables
+// generated ahead of time rather than by buildSpans().
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawSpans(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t spans[], const uint8_t colorIndex[], const uint16_t pal[], boolean spansInProgmem)
+{
+	uint16_t palN[16];
+	loadPalette(pal, palN, 16);
+	uint16_t lineBuf[ST7735_PUSH_CHUNK/2];
+
+	waitIdle();
+	beginSPI();
+	for(uint8_t j = 0; j < h; j++)
+	{
+		uint8_t runs = spansInProgmem ? pgm_read_byte(spans) : *spans;
+		spans++;
+		int16_t py = y + j;
+		while(runs--)
+		{
+			int16_t rx = spansInProgmem ? pgm_read_byte(spans) : spans[0];
+			int16_t rw = spansInProgmem ? pgm_read_byte(spans+1) : spans[1];
+			spans += 2;
+			int16_t px = x + rx, pyc = py, rh = 1;
+			if(!clipRect(px, pyc, rw, rh)) continue;
+
+			const uint8_t *src = &colorIndex[j * w + (px - x)];
+			writeAddrWindow(px, py, px + rw - 1, py);
+			while(rw)
+			{
+				uint8_t k = (rw < ST7735_PUSH_CHUNK/2) ? rw : ST7735_PUSH_CHUNK/2;
+				for(uint8_t i = 0; i < k; i++) lineBuf[i] = palN[pgm_read_byte(src++)];
+				pushNative(lineBuf, k);
+				rw -= k;
+			}
+		}
+	}
+	endDraw();
+}
+
+//Draw Slow Color BMPs, with transparency.
+//At present im not sure its possible to draw transparent BMPs with setAddrWindow set to the size of the graphic.
+//setAddrWindow needs to be provided with data to fill the entire space, it doesnt have a 'skip pixel' byte im aware of.
+// Palette into RAM, already in the controller's pixel format, so the
+// blitters do one PROGMEM read and conversion per entry instead of per pixel.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::loadPalette(const uint16_t pal[], uint16_t *out, uint8_t n)
+{
+	for(uint8_t i = 0; i < n; i++) out[i] = toNative(pgm_read_word(&pal[i]));
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::loadPalette(const uint8_t pal_lo[], const uint8_t pal_hi[], uint16_t *out, uint8_t n)
+{
+	for(uint8_t i = 0; i < n; i++)
+		out[i] = toNative(((uint16_t)pgm_read_byte(&pal_hi[i]) << 8) | pgm_read_byte(&pal_lo[i]));
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawColorBitmap(int16_t x, int16_t y,
+  const uint8_t bitmap[], int16_t w, int16_t h, const uint8_t colorIndex[], const uint16_t pal[], uint16_t bg) {
+
+    int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
+    uint8_t byte = 0;
 	// rudimentary clipping (drawChar w/big text requires this)
 	if((x >= _width) || (y >= _height)) return;
 	if((x + w - 1) >= _width)  w = _width  - x;
@@ -577,133 +1560,390 @@ void Adafruit_ST7735::drawColorBitmap(int16_t x, int16_t y,
     }
 }
 
-void Adafruit_ST7735::drawFont(uint8_t x, uint8_t y,String text)
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawFont(int16_t x, int16_t y, String text)
+{
+	drawFont(x, y, text.c_str());
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawFont(int16_t x, int16_t y, const char *text)
 {
-	//A=65: tileID=10:
-	//0=48: tileID=0:
-	//can put special chars between 57&65(6chars) to get rid of if statement.
-	uint8_t tileID;
-	//uint8_t asciiOffset = 55; // adjust from ascii code to tileID
-	uint8_t xOffset;
-	uint8_t len = text.length();
-	for(uint8_t i =0; i< len; i++)
+	drawFont(x, y, text, pgm_read_word(&fontCol[0]), pgm_read_word(&fontCol[1]));
+}
+
+//0=48: tileID=0; codes outside the set come out as tile 11, a space.
+static inline uint8_t fontTile(char c)
+{
+	uint8_t tileID = c - 48;
+	return (tileID > 50) ? 11 : tileID;
+}
+
+// The whole string goes out in one (8*len) x 8 window: each scanline runs
+// across the row byte of every glyph, a nibble at a time through a table
+// of four ready-made native pixels.  set/clear are the colours of set and
+// clear glyph bits (tileFont draws its ink with clear bits).
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawFont(int16_t x, int16_t y, const char *text, uint16_t set, uint16_t clear)
+{
+	uint8_t tiles[ST7735_MAX_TILE_RUN];
+	uint8_t count = 0;
+	while(count < ST7735_MAX_TILE_RUN && text[count]) { tiles[count] = fontTile(text[count]); count++; }
+	if(!count) return;
+	if(!stripFits(x, y, FONT_TILESZ * count, FONT_TILESZ))
 	{
-		tileID = text[i] - 48;
-		if(tileID > 50)
+		for(uint8_t t = 0; t < count; t++)
+			drawFastBitmap(x + t*FONT_TILESZ, y, &tileFont[tiles[t] * FONT_TILESZ], FONT_TILESZ, FONT_TILESZ, set, clear);
+	}
+	else
+	{
+		uint16_t setN = toNative(set), clearN = toNative(clear);
+		uint16_t expand[16][4];
+		for(uint8_t n = 0; n < 16; n++)
+			for(uint8_t b = 0; b < 4; b++) expand[n][b] = (n & (8 >> b)) ? setN : clearN;
+
+		uint16_t lineBuf[ST7735_PUSH_CHUNK/2];
+		uint8_t  k = 0;
+		startDraw(x, y, x + FONT_TILESZ*count - 1, y + FONT_TILESZ - 1);
+		for(uint8_t j = 0; j < FONT_TILESZ; j++)
 		{
-			tileID = 11;//space
+			for(uint8_t t = 0; t < count; t++)
+			{
+				uint8_t byte = pgm_read_byte(&tileFont[tiles[t] * FONT_TILESZ + j]);
+				memcpy(&lineBuf[k], expand[byte >> 4], sizeof(expand[0]));
+				memcpy(&lineBuf[k + 4], expand[byte & 0xF], sizeof(expand[0]));
+				k += 8;
+				if(k + 8 > ST7735_PUSH_CHUNK/2)
+				{
+					pushNative(lineBuf, k);
+					k = 0;
+				}
+			}
 		}
-		drawCBMPsection(x+xOffset, y, FONT_TILESZ, FONT_TILESZ, tileFont, fontCol, FONT_WIDTH, FONT_HEIGHT, tileID, false, false,1);
-		//drawFastBitmap(x+xOffset, y,tileFont, 8, 8, fontCol[0],fontCol[1]);
-		xOffset += 8;
+		if(k) pushNative(lineBuf, k);
+		endDraw();
 	}
+	//a longer string carries on in the next window
+	if(text[count]) drawFont(x + FONT_TILESZ*count, y, text + count, set, clear);
 }
 
-uint8_t Adafruit_ST7735::rle_4_bit(uint8_t &input, uint8_t &outputColor, uint8_t &outputLength)
+// Coverage c of 15 blended from bg to fg, per RGB565 channel.  Done once
+// here so drawAAText() costs the same as a packed tile blit.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::setAAColors(uint16_t fg, uint16_t bg)
 {
-	outputLength = (input >> 4) & 0xF;
-	outputColor = input & 0xF;
+	for(uint8_t c = 0; c < 16; c++)
+	{
+		uint16_t r = (((fg >> 11) & 0x1F) * c + ((bg >> 11) & 0x1F) * (15 - c) + 7) / 15;
+		uint16_t g = (((fg >> 5) & 0x3F) * c + ((bg >> 5) & 0x3F) * (15 - c) + 7) / 15;
+		uint16_t b = ((fg & 0x1F) * c + (bg & 0x1F) * (15 - c) + 7) / 15;
+		_aaPal[c] = (r << 11) | (g << 5) | b;
+	}
 }
 
-uint8_t Adafruit_ST7735::rle_1_bit(uint8_t &input, uint8_t &outputColor, uint8_t &outputLength)
+// Like drawFont(): the string goes out in one window, a scanline at a time
+// across every glyph, unpacked through the setAAColors() blend.  2 bit
+// coverage uses every fifth step of it (0, 1/3, 2/3, 1).
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawAAText(int16_t x, int16_t y, const char *text, const ST7735_AAFont &font)
 {
-	outputLength = (input >> 4) & 0xF;
-	outputColor = input & 0xF;
+	if((font.bits != 2) && (font.bits != 4)) return; //the blend palette has 16 entries
+	uint16_t palN[16];
+	uint8_t  levels = 1 << font.bits;
+	uint8_t  step = (font.bits == 2) ? 5 : 1;
+	for(uint8_t i = 0; i < levels; i++) palN[i] = toNative(_aaPal[i * step]);
+
+	uint8_t  gw = font.glyphW, gh = font.glyphH;
+	uint16_t rowBytes = ((uint16_t)gw * font.bits + 7) / 8;
+	int16_t  glyph[ST7735_MAX_TILE_RUN]; //-1: not in the font, drawn blank
+	uint8_t  count = 0;
+	for(; (count < ST7735_MAX_TILE_RUN) && text[count]; count++)
+	{
+		uint8_t c = text[count] - font.first;
+		glyph[count] = (c < font.count) ? c : -1;
+	}
+	if(!count) return;
+
+	if(!stripFits(x, y, gw * count, gh))
+	{
+		for(uint8_t t = 0; t < count; t++)
+		{
+			if(glyph[t] < 0) fillRect(x + t*gw, y, gw, gh, _aaPal[0]);
+			else drawSectionPacked(x + t*gw, y, gw, gh, font.data, palN, gw, glyph[t], 0, font.bits);
+		}
+	}
+	else
+	{
+		uint16_t lineBuf[ST7735_PUSH_CHUNK/2];
+		uint8_t  k = 0;
+		startDraw(x, y, x + gw*count - 1, y + gh - 1);
+		for(uint8_t j = 0; j < gh; j++)
+		{
+			for(uint8_t t = 0; t < count; t++)
+			{
+				if(glyph[t] >= 0)
+				{
+					pushPackedRow(&font.data[((uint16_t)glyph[t] * gh + j) * rowBytes], 0, gw, font.bits, palN, lineBuf, k);
+					continue;
+				}
+				if(k) pushNative(lineBuf, k);
+				k = 0;
+				pushNativeRepeat(palN[0], gw);
+			}
+		}
+		if(k) pushNative(lineBuf, k);
+		endDraw();
+	}
+	//a longer string carries on in the next window
+	if(text[count]) drawAAText(x + gw*count, y, text + count, font);
 }
 
-void Adafruit_ST7735::drawFastVLine(int16_t x, int16_t y, int16_t h,
- uint16_t color) {
+// GFXfont glyph c copied out of PROGMEM, false if the font lacks it
+static boolean fontGlyph(const GFXfont *font, uint8_t c, GFXglyph &g)
+{
+	uint8_t first = pgm_read_byte(&font->first);
+	if((c < first) || (c > pgm_read_byte(&font->last))) return false;
+	const GFXglyph *p = &((const GFXglyph *)pgm_read_pointer(&font->glyph))[c - first];
+	g.bitmapOffset = pgm_read_word(&p->bitmapOffset);
+	g.width    = pgm_read_byte(&p->width);
+	g.height   = pgm_read_byte(&p->height);
+	g.xAdvance = pgm_read_byte(&p->xAdvance);
+	g.xOffset  = (int8_t)pgm_read_byte(&p->xOffset);
+	g.yOffset  = (int8_t)pgm_read_byte(&p->yOffset);
+	return true;
+}
 
-  // Rudimentary clipping
-  if((x >= _width) || (y >= _height)) return;
-  if((y+h-1) >= _height) h = _height-y;
-  setAddrWindow(x, y, x, y+h-1);
+//glyph bitmaps are one bit stream, rows are not padded
+static inline boolean fontBit(const uint8_t *bitmap, uint32_t bit)
+{
+	return pgm_read_byte(&bitmap[bit >> 3]) & (0x80 >> (bit & 7));
+}
 
-  uint8_t hi = color >> 8, lo = color;
-    
-#if defined (SPI_HAS_TRANSACTION)
-  //SPI.beginTransaction(mySPISettings);
-#endif
+// Top and bottom of the line box, relative to the baseline, over every
+// glyph of the font.  Only worked out again when the font changes.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::fontExtents(const GFXfont *font)
+{
+	if(font == _extFont) return;
+	GFXglyph g;
+	int16_t top = 0, bottom = 0;
+	uint8_t first = pgm_read_byte(&font->first), last = pgm_read_byte(&font->last);
+	for(uint8_t c = first; ; c++)
+	{
+		fontGlyph(font, c, g);
+		if(g.yOffset < top) top = g.yOffset;
+		if(g.yOffset + g.height > bottom) bottom = g.yOffset + g.height;
+		if(c == last) break;
+	}
+	_extTop = top;
+	_extBottom = bottom;
+	_extFont = font;
+}
 
-  DC_HIGH();
-  CS_LOW();
-  while (h--) {
-    spiwrite(hi);
-    spiwrite(lo);
-  }
-  CS_HIGH();
+// Opaque GFXfont text: the whole line box goes out in one window, the
+// background included, instead of a drawPixel() window per set pixel.
+// The box is as tall as the font's tallest glyph extents, so a shorter
+// string still covers what a longer one left behind, and as wide as the
+// pen advance plus any overhang.  Each scanline is gathered into a 1bpp
+// row of the box from every glyph it crosses, then expanded to colours.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawText(int16_t x, int16_t y, const char *text, const GFXfont *font, uint16_t color, uint16_t bg)
+{
+	drawTextBox(x, y, text, font, color, bg, SHRT_MIN);
+}
 
-#if defined (SPI_HAS_TRANSACTION)
-  //SPI.endTransaction();
-#endif
+// drawText() with the box starting no further left than keepX, so what
+// is there already is left alone.  Returns the right end of the box.
+template<class Transport>
+int16_t Adafruit_ST7735T<Transport>::drawTextBox(int16_t x, int16_t y, const char *text, const GFXfont *font, uint16_t color, uint16_t bg, int16_t keepX)
+{
+	GFXglyph g;
+	fontExtents(font);
+	int16_t top = _extTop, bottom = _extBottom;
+	int16_t left = x, right = x, pen = x;
+	for(const char *s = text; *s; s++)
+	{
+		if(!fontGlyph(font, *s, g)) continue;
+		int16_t gl = pen + g.xOffset, gr = gl + g.width;
+		if(gl < left) left = gl;
+		if(gr > right) right = gr;
+		pen += g.xAdvance;
+		if(pen > right) right = pen;
+	}
+	if(left < keepX) left = keepX;
+
+	int16_t bx = left, by = y + top, bw = right - left, bh = bottom - top;
+	if(!clipRect(bx, by, bw, bh)) return right;
+
+	const uint8_t *bitmap = (const uint8_t *)pgm_read_pointer(&font->bitmap);
+	uint8_t  mask[(ST7735_TFTHEIGHT_160 + 7) / 8];
+	uint16_t lineBuf[ST7735_PUSH_CHUNK/2];
+	uint8_t  k = 0;
+	color = toNative(color);
+	bg    = toNative(bg);
+
+	startDraw(bx, by, bx + bw - 1, by + bh - 1);
+	for(int16_t py = by; py < by + bh; py++)
+	{
+		memset(mask, 0, (bw + 7) / 8);
+		pen = x;
+		for(const char *s = text; *s; s++)
+		{
+			if(!fontGlyph(font, *s, g)) continue;
+			int16_t j = py - (y + g.yOffset);
+			if((j >= 0) && (j < g.height))
+			{
+				uint32_t bit = (uint32_t)g.bitmapOffset * 8 + (uint16_t)j * g.width;
+				int16_t  mx = pen + g.xOffset - bx;
+				for(uint8_t i = 0; i < g.width; i++, bit++, mx++)
+				{
+					if((mx >= 0) && (mx < bw) && fontBit(bitmap, bit)) mask[mx >> 3] |= 0x80 >> (mx & 7);
+				}
+			}
+			pen += g.xAdvance;
+		}
+		for(int16_t i = 0; i < bw; i++)
+		{
+			lineBuf[k++] = (mask[i >> 3] & (0x80 >> (i & 7))) ? color : bg;
+			if(k == ST7735_PUSH_CHUNK/2)
+			{
+				pushNative(lineBuf, k);
+				k = 0;
+			}
+		}
+	}
+	if(k) pushNative(lineBuf, k);
+	endDraw();
+	return right;
 }
 
+// Transparent GFXfont text: the opaque runs of each glyph row are found
+// on the fly and each gets the smallest window setup the cache allows and
+// a repeat push, like drawSpans(), all in one bus transaction.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawText(int16_t x, int16_t y, const char *text, const GFXfont *font, uint16_t color)
+{
+	const uint8_t *bitmap = (const uint8_t *)pgm_read_pointer(&font->bitmap);
+	color = toNative(color);
 
-void Adafruit_ST7735::drawFastHLine(int16_t x, int16_t y, int16_t w,
-  uint16_t color) {
+	waitIdle();
+	beginSPI();
+	for(int16_t pen = x; *text; text++)
+	{
+		GFXglyph g;
+		if(!fontGlyph(font, *text, g)) continue;
+		uint32_t bit = (uint32_t)g.bitmapOffset * 8;
+		for(uint8_t j = 0; j < g.height; j++, bit += g.width)
+		{
+			int16_t py = y + g.yOffset + j;
+			uint8_t i = 0;
+			while(i < g.width)
+			{
+				while((i < g.width) && !fontBit(bitmap, bit + i)) i++;
+				if(i >= g.width) break;
+				uint8_t start = i;
+				while((i < g.width) && fontBit(bitmap, bit + i)) i++;
+				int16_t px = pen + g.xOffset + start, pyc = py, rw = i - start, rh = 1;
+				if(!clipRect(px, pyc, rw, rh)) continue;
+				writeAddrWindow(px, py, px + rw - 1, py);
+				pushNativeRepeat(color, rw);
+			}
+		}
+		pen += g.xAdvance;
+	}
+	endDraw();
+}
 
-  // Rudimentary clipping
-  if((x >= _width) || (y >= _height)) return;
-  if((x+w-1) >= _width)  w = _width-x;
-  setAddrWindow(x, y, x+w-1, y);
+template<class Transport>
+size_t Adafruit_ST7735T<Transport>::write(uint8_t c)
+{
+	if(!gfxFont || (textsize != 1)) return Adafruit_GFX::write(c);
+	if(c == '\n')
+	{
+		cursor_x  = 0;
+		cursor_y += pgm_read_byte(&gfxFont->yAdvance);
+		return 1;
+	}
+	GFXglyph g;
+	if((c == '\r') || !fontGlyph(gfxFont, c, g)) return 1;
+	if(wrap && (cursor_x + g.xOffset + g.width > _width))
+	{
+		cursor_x  = 0;
+		cursor_y += pgm_read_byte(&gfxFont->yAdvance);
+	}
+	char s[2] = { (char)c, 0 };
+	if(textbgcolor == textcolor) drawText(cursor_x, cursor_y, s, gfxFont, textcolor);
+	else
+	{
+		//straight after the previous glyph its box is left standing, so
+		//neither glyph's overhang gets painted over with background; any
+		//of this glyph's ink that falls in there goes on transparently
+		int16_t keep = ((cursor_x == _textEndX) && (cursor_y == _textEndY)) ? _textRight : SHRT_MIN;
+		_textRight = drawTextBox(cursor_x, cursor_y, s, gfxFont, textcolor, textbgcolor, keep);
+		if(cursor_x + g.xOffset < keep) drawText(cursor_x, cursor_y, s, gfxFont, textcolor);
+		_textEndX = cursor_x + g.xAdvance;
+		_textEndY = cursor_y;
+	}
+	cursor_x += g.xAdvance;
+	return 1;
+}
 
-  uint8_t hi = color >> 8, lo = color;
+template<class Transport>
+uint8_t Adafruit_ST7735T<Transport>::rle_4_bit(uint8_t &input, uint8_t &outputColor, uint8_t &outputLength)
+{
+	outputLength = (input >> 4) & 0xF;
+	outputColor = input & 0xF;
+}
 
-#if defined (SPI_HAS_TRANSACTION)
-  //SPI.beginTransaction(mySPISettings);
-#endif
+template<class Transport>
+uint8_t Adafruit_ST7735T<Transport>::rle_1_bit(uint8_t &input, uint8_t &outputColor, uint8_t &outputLength)
+{
+	outputLength = (input >> 4) & 0xF;
+	outputColor = input & 0xF;
+}
 
-  DC_HIGH();
-  CS_LOW();
-  while (w--) {
-    spiwrite(hi);
-    spiwrite(lo);
-  }
-  CS_HIGH();
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawFastVLine(int16_t x, int16_t y, int16_t h,
+ uint16_t color) {
 
-#if defined (SPI_HAS_TRANSACTION)
-  //SPI.endTransaction();
-#endif
+  int16_t w = 1;
+  if(!clipRect(x, y, w, h)) return;
+  startDraw(x, y, x, y+h-1);
+  pushColorRepeat(color, h);
+  endDraw();
 }
 
 
+template<class Transport>
+void Adafruit_ST7735T<Transport>::drawFastHLine(int16_t x, int16_t y, int16_t w,
+  uint16_t color) {
 
-void Adafruit_ST7735::fillScreen(uint16_t color) {
+  int16_t h = 1;
+  if(!clipRect(x, y, w, h)) return;
+  startDraw(x, y, x+w-1, y);
+  pushColorRepeat(color, w);
+  endDraw();
+}
+
+
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::fillScreen(uint16_t color) {
   fillRect(0, 0,  _width, _height, color);
 }
 
 
 
 // fill a rectangle
-void Adafruit_ST7735::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+template<class Transport>
+void Adafruit_ST7735T<Transport>::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
   uint16_t color) {
 
-  // rudimentary clipping (drawChar w/big text requires this)
-  if((x >= _width) || (y >= _height)) return;
-  if((x + w - 1) >= _width)  w = _width  - x;
-  if((y + h - 1) >= _height) h = _height - y;
+  if(!clipRect(x, y, w, h)) return;
 
-  setAddrWindow(x, y, x+w-1, y+h-1);
-
-  uint8_t hi = color >> 8, lo = color;
-    
-#if defined (SPI_HAS_TRANSACTION)
-  //SPI.beginTransaction(mySPISettings);
-#endif
-
-  DC_HIGH();
-  CS_LOW();
-  for(y=h; y>0; y--) {
-    for(x=w; x>0; x--) {
-      spiwrite(hi);
-      spiwrite(lo);
-    }
-  }
-  CS_HIGH();
-
-#if defined (SPI_HAS_TRANSACTION)
-  //SPI.endTransaction();
-#endif
+  startDraw(x, y, x+w-1, y+h-1);
+  pushColorRepeat(color, (uint32_t)w * h);
+  endDraw();
 }
 
 #define MADCTL_MY  0x80
@@ -714,13 +1954,15 @@ void Adafruit_ST7735::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
 #define MADCTL_BGR 0x08
 #define MADCTL_MH  0x04
 
-void Adafruit_ST7735::setRotation(uint8_t m) {
+template<class Transport>
+void Adafruit_ST7735T<Transport>::setRotation(uint8_t m) {
 
   writecommand(ST7735_MADCTL);
   rotation = m % 4; // can't be higher than 3
   switch (rotation) {
    case 0:
-	writedata(MADCTL_MX | MADCTL_MY | MADCTL_BGR);
+	_madctl = MADCTL_MX | MADCTL_MY | MADCTL_BGR;
+       writedata(_madctl);
 
 
 	_height = ST7735_TFTHEIGHT_128;
@@ -729,7 +1971,8 @@ void Adafruit_ST7735::setRotation(uint8_t m) {
      break;
    case 1:
 
-       writedata(MADCTL_MY | MADCTL_MV | MADCTL_BGR);
+       _madctl = MADCTL_MY | MADCTL_MV | MADCTL_BGR;
+       writedata(_madctl);
 
 
 
@@ -739,14 +1982,16 @@ void Adafruit_ST7735::setRotation(uint8_t m) {
      break;
   case 2:
 
-       writedata(MADCTL_BGR);
+       _madctl = MADCTL_BGR;
+       writedata(_madctl);
        _height = ST7735_TFTHEIGHT_128;
        _width  = ST7735_TFTWIDTH_128;
 
      break;
    case 3:
 
-       writedata(MADCTL_MX | MADCTL_MV | MADCTL_BGR);
+       _madctl = MADCTL_MX | MADCTL_MV | MADCTL_BGR;
+       writedata(_madctl);
 
        _width = ST7735_TFTHEIGHT_128;
        _height = ST7735_TFTWIDTH_128;
@@ -756,18 +2001,199 @@ void Adafruit_ST7735::setRotation(uint8_t m) {
   }
   ystart = colstart;
   xstart = rowstart;
+  _drawMadctl = _madctl;
+  _winValid = false;
+  setClip(0, _height);
+}
+
+// GRAM column/row that raw address (a, b) lands on under MADCTL value m.
+// With MV set CASET addresses rows, and MY/MX mirror the exchanged axes.
+static void gramPos(uint8_t m, int16_t a, int16_t b, int16_t &pc, int16_t &pr)
+{
+  if(m & MADCTL_MV) {
+    pr = (m & MADCTL_MY) ? (ST7735_GRAM_HEIGHT - 1) - a : a;
+    pc = (m & MADCTL_MX) ? (ST7735_GRAM_WIDTH - 1) - b : b;
+  } else {
+    pc = (m & MADCTL_MX) ? (ST7735_GRAM_WIDTH - 1) - a : a;
+    pr = (m & MADCTL_MY) ? (ST7735_GRAM_HEIGHT - 1) - b : b;
+  }
+}
+
+// Inverse of gramPos(): the raw address of GRAM cell (pc, pr) under m.
+static void gramAddr(uint8_t m, int16_t pc, int16_t pr, int16_t &a, int16_t &b)
+{
+  if(m & MADCTL_MV) {
+    a = (m & MADCTL_MY) ? (ST7735_GRAM_HEIGHT - 1) - pr : pr;
+    b = (m & MADCTL_MX) ? (ST7735_GRAM_WIDTH - 1) - pc : pc;
+  } else {
+    a = (m & MADCTL_MX) ? (ST7735_GRAM_WIDTH - 1) - pc : pc;
+    b = (m & MADCTL_MY) ? (ST7735_GRAM_HEIGHT - 1) - pr : pr;
+  }
+}
+
+// Mirrored and turned draws without touching the decoders: pick the MADCTL
+// whose scan order walks the footprint the way the transformed source
+// reads, and open a w x h window in that address space.  The source is
+// then streamed forward as usual; endDraw() puts back setRotation()'s MADCTL.
+template<class Transport>
+boolean Adafruit_ST7735T<Transport>::startOriented(int16_t x, int16_t y, uint8_t w, uint8_t h, uint8_t orient)
+{
+  if(!orient) {
+    startDraw(x, y, x+w-1, y+h-1);
+    return true;
+  }
+  boolean turn = orient & ST7735_ROTATE_90;
+  if(!stripFits(x, y, turn ? h : w, turn ? w : h)) return false;
+
+  // screen position of source (0,0), and screen steps for source +x and +y
+  int16_t ox = (orient & ST7735_FLIP_H) ? w - 1 : 0;
+  int16_t oy = (orient & ST7735_FLIP_V) ? h - 1 : 0;
+  int8_t  ix = (orient & ST7735_FLIP_H) ? -1 : 1, iy = 0;
+  int8_t  jx = 0, jy = (orient & ST7735_FLIP_V) ? -1 : 1;
+  if(turn) { // clockwise: (u, v) -> (h-1-v, u)
+    int16_t t = ox;
+    ox = h - 1 - oy; oy = t;
+    int8_t s = ix; ix = -iy; iy = s;
+    s = jx; jx = -jy; jy = s;
+  }
+  ox += x + xstart;
+  oy += y + ystart;
+
+  int16_t c0, r0, ci, ri, cj, rj;
+  gramPos(_madctl, ox, oy, c0, r0);
+  gramPos(_madctl, ox + ix, oy + iy, ci, ri);
+  gramPos(_madctl, ox + jx, oy + jy, cj, rj);
+
+  uint8_t m = _madctl & ~(MADCTL_MY | MADCTL_MX | MADCTL_MV);
+  if(ci == c0) { // source rows run down GRAM columns
+    m |= MADCTL_MV;
+    if(ri < r0) m |= MADCTL_MY;
+    if(cj < c0) m |= MADCTL_MX;
+  } else {
+    if(ci < c0) m |= MADCTL_MX;
+    if(rj < r0) m |= MADCTL_MY;
+  }
+  int16_t a, b;
+  gramAddr(m, c0, r0, a, b);
+  a -= xstart; // writeAddrWindow() adds the panel offsets back
+  b -= ystart;
+
+  waitIdle();
+  beginSPI();
+  if(m != _drawMadctl) {
+    endPixels();
+    DC_LOW();
+    spiwrite(ST7735_MADCTL);
+    DC_HIGH();
+    spiwrite(m);
+    _drawMadctl = m;
+    _winValid = false;
+  }
+  writeAddrWindow(a, b, a + w - 1, b + h - 1);
+  return true;
 }
 
 
-void Adafruit_ST7735::invertDisplay(boolean i) {
+template<class Transport>
+void Adafruit_ST7735T<Transport>::invertDisplay(boolean i) {
   writecommand(i ? ST7735_INVON : ST7735_INVOFF);
 }
 
 
+// Clip a rectangle to the screen and the active rows (see setPartialArea).
+// Returns false when nothing is left to draw.
+template<class Transport>
+boolean Adafruit_ST7735T<Transport>::clipRect(int16_t &x, int16_t &y, int16_t &w, int16_t &h) {
+  if(x < _clipX0) { w -= _clipX0 - x; x = _clipX0; }
+  if(y < _clipY0) { h -= _clipY0 - y; y = _clipY0; }
+  if(x + w > _clipX1) w = _clipX1 - x;
+  if(y + h > _clipY1) h = _clipY1 - y;
+  return (w > 0) && (h > 0);
+}
+
+template<class Transport>
+void Adafruit_ST7735T<Transport>::setClip(int16_t top, int16_t h) {
+  _clipX0 = 0;
+  _clipX1 = _width;
+  _clipY0 = top;
+  _clipY1 = top + h;
+}
+
+// Partial display mode: only logical rows [top, top+h) are refreshed from
+// RAM, and draw calls are clipped to them so nothing is sent for rows that
+// can't be seen.  Combine with idleMode(true) for the cheapest status strip.
+// Use rotation 0 or 2; call again after setRotation().
+template<class Transport>
+void Adafruit_ST7735T<Transport>::setPartialArea(uint8_t top, uint8_t h) {
+  uint8_t sr = gramRow(top), er = gramRow(top + h - 1);
+  if(sr > er) { uint8_t t = sr; sr = er; er = t; }
+  uint8_t args[] = { 0, sr, 0, er };
+
+  writecommand(ST7735_PTLAR, args, sizeof(args));
+  writecommand(ST7735_PTLON);
+  setClip(top, h);
+}
+
+// Back to full screen refresh, also drops the partial area clip.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::normalDisplay(void) {
+  writecommand(ST7735_NORON);
+  setClip(0, _height);
+}
+
+// Idle mode drops to 8 colours (MSB of each channel) to save power.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::idleMode(boolean i) {
+  writecommand(i ? ST7735_IDMON : ST7735_IDMOFF);
+}
+
+// Controller row for a logical row.  Scrolling and partial mode work on
+// physical GRAM rows, which run backwards when MADCTL_MY is set.
+// Only meaningful in rotations 0 and 2, where logical y runs along rows.
+template<class Transport>
+uint8_t Adafruit_ST7735T<Transport>::gramRow(uint8_t y) {
+  y += ystart;
+  return (_madctl & MADCTL_MY) ? (ST7735_GRAM_HEIGHT - 1) - y : y;
+}
+
+// Hardware vertical scrolling of logical rows [top, top+h).  Rows outside
+// the area stay put.  Use rotation 0 or 2.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::setScrollArea(uint8_t top, uint8_t h) {
+  uint8_t tfa = (_madctl & MADCTL_MY) ? gramRow(top + h - 1) : gramRow(top);
+  uint8_t bfa = ST7735_GRAM_HEIGHT - tfa - h;
+  uint8_t args[] = { 0, tfa, 0, h, 0, bfa };
+
+  _scrollTop = top;
+  _scrollHeight = h;
+  writecommand(ST7735_VSCRDEF, args, sizeof(args));
+  scrollTo(0);
+}
+
+// Show logical row top+offset at the top of the scroll area, wrapping
+// back round to top.  Only VSCRSADD goes out, no pixels are resent.
+template<class Transport>
+void Adafruit_ST7735T<Transport>::scrollTo(uint8_t offset) {
+  if(!_scrollHeight) return;
+  offset %= _scrollHeight;
+  uint8_t ssa;
+  if(_madctl & MADCTL_MY) {
+    // scan runs bottom to top of the logical area
+    ssa = gramRow(_scrollTop + _scrollHeight - 1) + (_scrollHeight - offset) % _scrollHeight;
+  } else {
+    ssa = gramRow(_scrollTop) + offset;
+  }
+  uint8_t args[] = { 0, ssa };
+  writecommand(ST7735_VSCRSADD, args, sizeof(args));
+}
+
+
 /******** low level bit twiddling **********/
 
 
-inline void Adafruit_ST7735::CS_HIGH(void) {
+template<class Transport>
+inline void Adafruit_ST7735T<Transport>::CS_HIGH(void) {
+  ST7735_STAT(csToggles, 1);
 #if defined(USE_FAST_IO)
   *csport |= cspinmask;
 #else
@@ -775,7 +2201,9 @@ inline void Adafruit_ST7735::CS_HIGH(void) {
 #endif
 }
 
-inline void Adafruit_ST7735::CS_LOW(void) {
+template<class Transport>
+inline void Adafruit_ST7735T<Transport>::CS_LOW(void) {
+  ST7735_STAT(csToggles, 1);
 #if defined(USE_FAST_IO)
   *csport &= ~cspinmask;
 #else
@@ -783,7 +2211,9 @@ inline void Adafruit_ST7735::CS_LOW(void) {
 #endif
 }
 
-inline void Adafruit_ST7735::DC_HIGH(void) {
+template<class Transport>
+inline void Adafruit_ST7735T<Transport>::DC_HIGH(void) {
+  ST7735_STAT(dcToggles, 1);
 #if defined(USE_FAST_IO)
   *dcport |= dcpinmask;
 #else
@@ -791,10 +2221,19 @@ inline void Adafruit_ST7735::DC_HIGH(void) {
 #endif
 }
 
-inline void Adafruit_ST7735::DC_LOW(void) {
+template<class Transport>
+inline void Adafruit_ST7735T<Transport>::DC_LOW(void) {
+  ST7735_STAT(dcToggles, 1);
 #if defined(USE_FAST_IO)
   *dcport &= ~dcpinmask;
 #else
   digitalWrite(_dc, LOW);
 #endif
 }
+
+// The drivers a sketch can name; see the typedefs in Adafruit_ST7735.h.
+template class Adafruit_ST7735T<ST7735_HwSPI>;
+template class Adafruit_ST7735T<ST7735_SwSPI>;
+#if defined(ST7735_HOST)
+template class Adafruit_ST7735T<ST7735_CaptureSPI>;
+#endif
@@ -69,6 +69,14 @@ as well as Adafruit raw 1.8" TFT display
 #define ST7735_TFTHEIGHT_128 128
 // for 1.8" and mini display
 #define ST7735_TFTHEIGHT_160  160
+// controller RAM (132x162), used by scrolling/partial mode and flipped draws
+#define ST7735_GRAM_WIDTH  132
+#define ST7735_GRAM_HEIGHT 162
+
+// orientation bits for startOriented(), applied as flips then a clockwise turn
+#define ST7735_FLIP_H    0x01
+#define ST7735_FLIP_V    0x02
+#define ST7735_ROTATE_90 0x04
 
 #define ST7735_NOP     0x00
 #define ST7735_SWRESET 0x01
@@ -90,6 +98,10 @@ as well as Adafruit raw 1.8" TFT display
 #define ST7735_RAMRD   0x2E
 
 #define ST7735_PTLAR   0x30
+#define ST7735_VSCRDEF 0x33
+#define ST7735_VSCRSADD 0x37
+#define ST7735_IDMOFF  0x38
+#define ST7735_IDMON   0x39
 #define ST7735_COLMOD  0x3A
 #define ST7735_MADCTL  0x36
 
@@ -127,6 +139,8 @@ as well as Adafruit raw 1.8" TFT display
 #define ST7735_WHITE   0xFFFF
 
 
+#include "ST7735_Transport.h"
+
 #ifndef pgm_read_byte
  #define pgm_read_byte(addr) (*(const unsigned char *)(addr))
 #endif
@@ -136,11 +150,56 @@ as well as Adafruit raw 1.8" TFT display
 #ifndef pgm_read_dword
  #define pgm_read_dword(addr) (*(const unsigned long *)(addr))
 #endif
+#ifndef pgm_read_pointer
+ #if !defined(__INT_MAX__) || (__INT_MAX__ > 0xFFFF)
+  #define pgm_read_pointer(addr) ((void *)pgm_read_dword(addr))
+ #else
+  #define pgm_read_pointer(addr) ((void *)pgm_read_word(addr))
+ #endif
+#endif
 
 #define FONT_WIDTH 8
 #define FONT_HEIGHT 352
 #define FONT_TILESZ 8
 
+// setColorMode() values, these are the COLMOD arguments
+#define COLOR_444 0x03 // 12-bit, 2 pixels in 3 bytes
+#define COLOR_565 0x05 // 16-bit
+
+// most tiles drawTiles()/drawTilesRLE() put in one window
+#define ST7735_MAX_TILE_RUN 20
+
+// RLE format, in the high byte of tileAddr[0] (the low byte is the tile
+// count).  0 reads as V1 so existing tables keep working.
+// V1: one byte per run, colour<<4 | (length-1), 16 colours.
+// V2: 16 colours.  0LLLcccc is a run of LLL+1 pixels, LLL=7 takes the
+//     length from the next byte as 8+n.  1nnnnnnn is a literal packet of
+//     n+1 pixels, two per byte high nibble first, padded to a whole byte.
+// V3: 256 colours, PackBits style.  1nnnnnnn is a run of n+1 pixels of the
+//     index in the next byte, 0nnnnnnn a literal packet of n+1 index bytes.
+//     The palette stays in PROGMEM and is read once per run or literal.
+#define ST7735_RLE_V1 1
+#define ST7735_RLE_V2 2
+#define ST7735_RLE_V3 3
+
+// Optional RLE row index, so a clipped draw can start part way down a
+// tile: rowIndex[0] = N, rowIndex[1] = E entries per tile, then per tile E
+// pairs for rows N, 2N, ... : the offset from the tile start of the packet
+// holding the row's first pixel, and how many pixels of that packet
+// belong to earlier rows.
+
+// uncomment to count bus traffic, see stats()
+//#define ST7735_PROTOCOL_STATS
+
+#if defined(ST7735_PROTOCOL_STATS)
+// What went over the bus, and what the address-window cache and held CS
+// saved compared to sending every byte as its own CS-framed write.
+struct ST7735_Stats {
+  uint32_t bytes, csToggles, dcToggles;
+  uint32_t bytesSaved, csSaved, dcSaved;
+};
+#endif
+
 const uint16_t PROGMEM fontCol[] = { 0xFFFF,0x0000 };
 
 const uint16_t PROGMEM emptyTiles[] = {1,0};
@@ -501,16 +560,85 @@ const unsigned char PROGMEM tileFont[] =
     0xff
 };
 
-class Adafruit_ST7735 : public Adafruit_GFX {
+// Decoder position inside an RLE tile stream, so several tiles can be
+// decoded a scanline at a time.
+struct ST7735_RLEState {
+  const uint8_t *p;
+  const uint16_t *pal; //PROGMEM palette, V3 only
+  uint16_t left;       //pixels left in the current run or literal packet
+  uint8_t color, fmt;
+  uint8_t lit, cur;    //literal packet state: 0 = run, else nibble phase
+};
+
+// drawCBMPsection() bitDepth for packed colour indices, two (4 bit) or
+// four (2 bit) pixels per byte.  Plain 4 is still one index per byte.
+#define ST7735_PACKED  0x20
+#define ST7735_PACKED4 (ST7735_PACKED | 4)
+#define ST7735_PACKED2 (ST7735_PACKED | 2)
+
+// Tile sheet written by extras/assetc: every tile is stored in whichever
+// format was cheapest for it, see drawAsset().  format[] holds the
+// drawCBMPsection() bitDepth (1, 4, ST7735_PACKED4, ST7735_PACKED2) or
+// ST7735_ASSET_RLE | an RLE format; offset[] is each tile's start in
+// data[].  pal has at least 16 entries.
+#define ST7735_ASSET_RLE 0x10
+
+struct ST7735_Asset {
+  uint8_t  tileW, tileH, count;
+  const uint8_t  *data;   //PROGMEM
+  const uint16_t *offset; //PROGMEM
+  const uint8_t  *format; //PROGMEM
+  const uint16_t *pal;    //PROGMEM
+};
 
+// Anti-aliased font, 2 or 4 bits of coverage per pixel (0 = background,
+// all ones = foreground).  Glyphs are stacked top to bottom like tileFont,
+// each glyphW x glyphH with rows padded to a whole byte, so the data is a
+// packed drawCBMPsection() sheet glyphW wide.  Covers the characters
+// first .. first+count-1, others are drawn blank.  Fonts with any other
+// bits value are not drawn.
+struct ST7735_AAFont {
+  uint8_t  glyphW, glyphH, bits, first, count;
+  const uint8_t *data; //PROGMEM
+};
+
+// Backend for the asynchronous line engine (see beginAsync()).
+// transfer() should start sending n bytes and return straight away,
+// busy() reports whether that transfer is still in flight.  A DMA
+// capable MCU implements these on its SPI DMA channel; the buffer
+// handed to transfer() is left alone until busy() returns false.
+class ST7735_LineBackend {
  public:
+  virtual void transfer(const uint8_t *buf, uint16_t n) = 0;
+  virtual bool busy(void) = 0;
+};
 
-  Adafruit_ST7735(int8_t CS, int8_t RS, int8_t RST = -1);
+// The driver, generic over its bus (see ST7735_Transport.h).  Use the
+// Adafruit_ST7735 (hardware SPI) and Adafruit_ST7735_SW (software SPI)
+// typedefs below; other transports need their own instantiation at the
+// end of Adafruit_ST7735.cpp.
+template<class Transport>
+class Adafruit_ST7735T : public Adafruit_GFX {
 
-  //need to update fill/hline/vline/etc to use these.
-  /*override void startWrite(int16_t x, int16_t y, int16_t w, int16_t h);
-  override void endWrite(void);
-  override void writePixel(int16_t x, int16_t y, uint16_t color);*/
+ public:
+
+  //hardware SPI, or any transport that needs no pins
+  template<class T = Transport>
+  Adafruit_ST7735T(int8_t CS, int8_t RS, int8_t RST = -1)
+    : Adafruit_GFX(ST7735_TFTWIDTH_128, ST7735_TFTHEIGHT_160) { setup(CS, RS, RST); }
+  //software SPI on SID and SCLK
+  template<class T = Transport>
+  Adafruit_ST7735T(int8_t CS, int8_t RS, int8_t SID, int8_t SCLK, int8_t RST = -1)
+    : Adafruit_GFX(ST7735_TFTWIDTH_128, ST7735_TFTHEIGHT_160), _bus(SID, SCLK) { setup(CS, RS, RST); }
+
+  //Adafruit_GFX write API, a primitive between startWrite() and
+  //endWrite() is one bus transaction
+  void     startWrite(void),
+           endWrite(void),
+           writePixel(int16_t x, int16_t y, uint16_t color),
+           writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color),
+           writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color),
+           writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
   
   void     initB(void),                             // for ST7735B displays
            initR(uint8_t options = INITR_GREENTAB), // for ST7735R
@@ -520,14 +648,25 @@ class Adafruit_ST7735 : public Adafruit_GFX {
            drawPixel(int16_t x, int16_t y, uint16_t color),
 		   drawFastPixel(uint8_t hi_c,uint8_t lo_c)/*NEED TO USE startDraw/endDraw before & after this function*/,
 		   startDraw(int16_t x, int16_t y, int16_t w, int16_t h),
-		   drawFont(uint8_t x, uint8_t y, String text), //Tilemap Font
+		   drawFont(int16_t x, int16_t y, String text), //Tilemap Font
+		   drawFont(int16_t x, int16_t y, const char *text),
+		   drawFont(int16_t x, int16_t y, const char *text, uint16_t set, uint16_t clear)/*one window per string*/,
+		   drawText(int16_t x, int16_t y, const char *text, const GFXfont *font, uint16_t color, uint16_t bg)/*GFXfont, y is the baseline, one window for the line box*/,
+		   drawText(int16_t x, int16_t y, const char *text, const GFXfont *font, uint16_t color)/*transparent, one window per run of set pixels*/,
+		   setAAColors(uint16_t fg, uint16_t bg)/*blend palette for drawAAText()*/,
+		   drawAAText(int16_t x, int16_t y, const char *text, const ST7735_AAFont &font)/*one window per string*/,
 		   drawFastBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color,uint16_t bg)/*DRAWS STANDALONE BITMAP. IF DRAWING TILES USE */,
 		   drawFastColorBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t colorIndex[], const uint16_t pal[],bool flipH,bool FlipV)/*DRAWS STANDALONE BITMAP. IF DRAWING TILES USE */,
 		   drawColorBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, const uint8_t colorIndex[], const uint16_t pal[], uint16_t bg)/*DRAWS STANDALONE BITMAP. IF DRAWING TILES USE */,
 		   //drawSurface(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t pal[], uint8_t imageW, uint8_t imageH, uint8_t sectionID)/*MUST USE START/END DRAW WITH THIS*/,
-		   drawCBMPsection(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t pal[], uint8_t imageW, uint8_t imageH, uint8_t sectionID,bool flipH,bool FlipV,uint8_t bitDepth),
-		   drawCBMPsectionRLE(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint16_t pal[], uint8_t imageW, uint8_t imageH, uint8_t sectionID, bool flipH, bool flipV),
-		   drawCBMPsectionRLE(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint8_t pal_lo[], const uint8_t pal_hi[], uint8_t imageW, uint8_t imageH, uint8_t sectionID, bool flipH, bool flipV),
+		   drawCBMPsection(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t pal[], uint8_t imageW, uint8_t imageH, uint8_t sectionID,bool flipH,bool FlipV,uint8_t bitDepth, bool rot90 = false),
+		   drawCBMPsectionRLE(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint16_t pal[], uint8_t imageW, uint8_t imageH, uint8_t sectionID, bool flipH, bool flipV, bool rot90 = false),
+		   drawCBMPsectionRLE(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint8_t pal_lo[], const uint8_t pal_hi[], uint8_t imageW, uint8_t imageH, uint8_t sectionID, bool flipH, bool flipV, bool rot90 = false),
+		   drawCBMPsectionRLE(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint16_t rowIndex[], const uint16_t pal[], uint8_t sectionID)/*rowIndex may be NULL*/,
+		   drawTiles(int16_t x, int16_t y, uint8_t tw, uint8_t th, const uint8_t tiles[], uint8_t count, const uint8_t colorIndex[], const uint16_t pal[], uint8_t imageW)/*one window per ST7735_MAX_TILE_RUN tiles*/,
+		   drawTilesRLE(int16_t x, int16_t y, uint8_t tw, uint8_t th, const uint8_t tiles[], uint8_t count, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint16_t pal[]),
+		   drawAsset(int16_t x, int16_t y, const ST7735_Asset &a, uint8_t tile, bool flipH = false, bool flipV = false, bool rot90 = false),
+		   drawSpans(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t spans[], const uint8_t colorIndex[], const uint16_t pal[], boolean spansInProgmem = false)/*transparent, see buildSpans()*/,
 		   endDraw(),
            drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color),
            drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color),
@@ -536,6 +675,51 @@ class Adafruit_ST7735 : public Adafruit_GFX {
            setRotation(uint8_t r),
            invertDisplay(boolean i);
   uint16_t Color565(uint8_t r, uint8_t g, uint8_t b);
+  //print() with a setFont() font goes through drawText(), transparent
+  //when the text background equals the text colour as in Adafruit_GFX
+  size_t   write(uint8_t c);
+  using    Print::write;
+  //startDraw() for a w x h source mirrored/turned by ST7735_FLIP_H/_V and
+  //ST7735_ROTATE_90; stream the source forward, finish with endDraw().
+  //false (nothing started) if the turned footprint is not fully on screen.
+  boolean  startOriented(int16_t x, int16_t y, uint8_t w, uint8_t h, uint8_t orient);
+  static uint16_t buildSpans(const uint8_t mask[], uint8_t w, uint8_t h, uint8_t *out, uint16_t outSize);
+
+  //Bulk pixel stream, NEED TO USE startDraw/endDraw before & after these.
+  void     pushColors(const uint16_t *colors, uint16_t n),
+           pushColorRepeat(uint16_t color, uint32_t n),
+           pushBytes(const uint8_t *data, uint16_t n);
+
+  void     setPartialArea(uint8_t top, uint8_t h),
+           normalDisplay(void),
+           idleMode(boolean i);
+
+  void     setScrollArea(uint8_t top, uint8_t h),
+           scrollTo(uint8_t offset);
+
+  //RLE/sheet decoding for code that composes its own scanlines
+  void     rleBegin(ST7735_RLEState &s, const uint8_t colorIndex[], const uint16_t tileAddr[], uint8_t tile, const uint16_t pal[] = NULL),
+           rleSeek(ST7735_RLEState &s, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint16_t rowIndex[], uint8_t tile, uint8_t row, uint8_t w, const uint16_t pal[] = NULL),
+           rleDecode(ST7735_RLEState &s, const uint16_t *pal, uint16_t *out, uint16_t n);
+  static uint16_t tileOffset(uint8_t tile, uint8_t w, uint8_t h, uint8_t imageW);
+
+  void     setColorMode(uint8_t mode);
+  uint8_t  getColorMode(void) { return _colorMode; }
+
+  //Async double-buffered mode: pixels pushed between startDraw/endDraw are
+  //packed into one line buffer while the other one is being sent.
+  //bufA/bufB must each hold len bytes (2 per pixel), e.g. one screen row.
+  //With no backend the lines are sent with a blocking SPI transfer.
+  void     beginAsync(uint8_t *bufA, uint8_t *bufB, uint16_t len, ST7735_LineBackend *backend = NULL),
+           endAsync(void),
+           waitIdle(void);
+
+  Transport &transport(void) { return _bus; } // e.g. the capture log on host builds
+
+#if defined(ST7735_PROTOCOL_STATS)
+  const ST7735_Stats &stats(void) { return _stats; }
+  void     resetStats(void) { memset(&_stats, 0, sizeof(_stats)); }
+#endif
   
   //int RLE_Uncompress( unsigned char *in, RLE_data *out, unsigned int insize ); //uncompress encoded bitmap/tilemap
   
@@ -553,11 +737,52 @@ class Adafruit_ST7735 : public Adafruit_GFX {
  private:
   uint8_t  tabcolor;
 
-  void     spiwrite(uint8_t),
+  void     setup(int8_t cs, int8_t dc, int8_t rst),
+           spiwrite(uint8_t),
+           spiwriteBuf(uint8_t *buf, uint16_t n),
            writecommand(uint8_t c),
            writedata(uint8_t d),
            commandList(const uint8_t *addr),
-           commonInit(const uint8_t *cmdList);
+           commonInit(const uint8_t *cmdList),
+           flushLine(void),
+           pushNative(const uint16_t *colors, uint16_t n),
+           pushNativeRepeat(uint16_t color, uint32_t n),
+           push444(const uint16_t *c, uint16_t n),
+           push444Repeat(uint16_t c, uint32_t n),
+           flush444(void),
+           endPixels(void),
+           loadPalette(const uint16_t pal[], uint16_t *out, uint8_t n),
+           loadPalette(const uint8_t pal_lo[], const uint8_t pal_hi[], uint16_t *out, uint8_t n),
+           drawSectionRLE(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t tileAddr[], const uint16_t rowIndex[], const uint16_t *palN, const uint16_t pal[], uint8_t sectionID, uint8_t orient),
+           drawSectionPacked(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t colorIndex[], const uint16_t *palN, uint8_t imageW, uint8_t sectionID, uint8_t orient, uint8_t bitDepth),
+           pushPackedRow(const uint8_t *p, uint8_t skip, uint8_t n, uint8_t bitDepth, const uint16_t *palN, uint16_t *lineBuf, uint8_t &k),
+           writecommand(uint8_t c, const uint8_t *args, uint8_t n),
+           writeAddrWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+  inline void lineByte(uint8_t b);
+  uint8_t  gramRow(uint8_t y);
+  boolean  clipRect(int16_t &x, int16_t &y, int16_t &w, int16_t &h),
+           clipOriented(int16_t &x, int16_t &y, uint8_t w, uint8_t h, uint8_t orient, uint8_t &si, uint8_t &sj, uint8_t &sw, uint8_t &sh),
+           stripFits(int16_t x, int16_t y, int16_t w, int16_t h);
+  int16_t  drawTextBox(int16_t x, int16_t y, const char *text, const GFXfont *font, uint16_t color, uint16_t bg, int16_t keepX);
+  void     fontExtents(const GFXfont *font);
+  void     rlePush(ST7735_RLEState &s, const uint16_t *palN, uint16_t n),
+           rlePushRect(ST7735_RLEState &s, const uint16_t *palN, uint8_t w, uint8_t si, uint8_t sw, uint8_t sh),
+           rleStart(ST7735_RLEState &s, const uint8_t *p, uint8_t fmt, const uint16_t pal[]),
+           rleNext(ST7735_RLEState &s);
+  inline uint8_t rleLiteral(ST7735_RLEState &s);
+  void     setClip(int16_t top, int16_t h);
+  inline void sendBuf(uint8_t *buf, uint8_t n);
+  static inline uint16_t to444(uint16_t c) {
+    return ((c >> 4) & 0xF00) | ((c >> 3) & 0x0F0) | ((c >> 1) & 0x00F);
+  }
+  static inline uint8_t orientBits(bool flipH, bool flipV, bool rot90) {
+    return (flipH ? ST7735_FLIP_H : 0) | (flipV ? ST7735_FLIP_V : 0) | (rot90 ? ST7735_ROTATE_90 : 0);
+  }
+  inline uint16_t toNative(uint16_t c) {
+    return (_colorMode == COLOR_444) ? to444(c) : c;
+  }
+  inline void beginSPI(void);
+  inline void endSPI(void);
 //uint8_t  spiread(void);
 
 
@@ -566,23 +791,61 @@ class Adafruit_ST7735 : public Adafruit_GFX {
   inline void DC_HIGH(void);
   inline void DC_LOW(void);
 
-  boolean  hwSPI;
+  Transport _bus;
 
-  int8_t  _cs, _dc, _rst, _sid, _sclk;
+  //async line engine
+  boolean  _async;
+  uint8_t *_lineBuf[2];
+  uint16_t _lineLen, _lineFill;
+  uint8_t  _lineCur;
+  ST7735_LineBackend *_backend;
+
+  int8_t  _cs, _dc, _rst;
   uint8_t colstart, rowstart, xstart, ystart; // some displays need this changed
 
+  uint8_t  _madctl; //as set by setRotation()
+  uint8_t  _drawMadctl; //currently in the controller, differs during oriented draws
+  uint8_t  _spiDepth; //beginSPI() nesting, the bus is only taken at 0
+  uint8_t  _scrollTop, _scrollHeight;
+  int16_t  _clipX0, _clipY0, _clipX1, _clipY1; //screen or partial area, ends exclusive
+
+  //COLMOD state, and the odd RGB444 pixel waiting for its partner
+  uint8_t  _colorMode;
+  boolean  _hasPend444;
+  uint16_t _pend444;
+
+  uint16_t _aaPal[16]; //RGB565 bg..fg blend from setAAColors()
+
+  //GFXfont line box extents of _extFont, from fontExtents()
+  const GFXfont *_extFont;
+  int8_t   _extTop, _extBottom;
+  //where the last opaque write() left the pen, and the right end of its box
+  int16_t  _textEndX, _textEndY, _textRight;
+
+  //last CASET/RASET sent to the controller
+  boolean  _winValid;
+  uint8_t  _winX0, _winX1, _winY0, _winY1;
+
+#if defined(ST7735_PROTOCOL_STATS)
+  ST7735_Stats _stats;
+  void     statSaved(const ST7735_Stats &before, uint16_t cs, uint16_t dc);
+#endif
+
 #if defined(USE_FAST_IO)
-  volatile RwReg  *dataport, *clkport, *csport, *dcport;
+  volatile RwReg  *csport, *dcport;
 
   #if defined(__AVR__) || defined(CORE_TEENSY)  // 8 bit!
-    uint8_t  datapinmask, clkpinmask, cspinmask, dcpinmask;
+    uint8_t  cspinmask, dcpinmask;
   #else    // 32 bit!
-    uint32_t  datapinmask, clkpinmask, cspinmask, dcpinmask;
+    uint32_t  cspinmask, dcpinmask;
   #endif
 #endif
 
 };
 
+typedef Adafruit_ST7735T<ST7735_HwSPI> Adafruit_ST7735;
+typedef Adafruit_ST7735T<ST7735_SwSPI> Adafruit_ST7735_SW;
+
 
 
 
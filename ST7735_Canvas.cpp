@@ -0,0 +1,224 @@
+// Off-screen canvas with dirty-rectangle flush, see ST7735_Canvas.h
+
+#include "ST7735_Canvas.h"
+#include <stdlib.h>
+
+ST7735_Canvas::ST7735_Canvas(int16_t w, int16_t h)
+  : Adafruit_GFX(w, h), _buf(NULL), _shadow(NULL), _shadowValid(false), _nDirty(0) {
+}
+
+ST7735_Canvas::~ST7735_Canvas(void) {
+  free(_buf);
+  free(_shadow);
+}
+
+boolean ST7735_Canvas::begin(boolean shadow) {
+  uint32_t bytes = (uint32_t)WIDTH * HEIGHT * 2;
+  free(_buf);
+  free(_shadow);
+  _shadow = NULL;
+  if(!(_buf = (uint16_t *)malloc(bytes))) return false;
+  memset(_buf, 0, bytes);
+  if(shadow && !(_shadow = (uint16_t *)malloc(bytes))) return false;
+  invalidate();
+  return true;
+}
+
+void ST7735_Canvas::invalidate(void) {
+  _shadowValid = false;
+  _nDirty = 0;
+  addDirty(0, 0, WIDTH - 1, HEIGHT - 1);
+}
+
+// Canvas coordinates to the unrotated buffer, as GFXcanvas16
+void ST7735_Canvas::toRaw(int16_t &x, int16_t &y) {
+  int16_t t;
+  switch(rotation) {
+    case 1: t = x; x = WIDTH  - 1 - y; y = t; break;
+    case 2: x = WIDTH  - 1 - x; y = HEIGHT - 1 - y; break;
+    case 3: t = x; x = y; y = HEIGHT - 1 - t; break;
+  }
+}
+
+// and back
+void ST7735_Canvas::toLogical(int16_t &x, int16_t &y) {
+  int16_t t;
+  switch(rotation) {
+    case 1: t = x; x = y; y = WIDTH  - 1 - t; break;
+    case 2: x = WIDTH  - 1 - x; y = HEIGHT - 1 - y; break;
+    case 3: t = x; x = HEIGHT - 1 - y; y = t; break;
+  }
+}
+
+void ST7735_Canvas::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if(!_buf || (x < 0) || (y < 0) || (x >= _width) || (y >= _height)) return;
+  toRaw(x, y);
+  _buf[y * WIDTH + x] = color;
+  addDirty(x, y, x, y);
+}
+
+void ST7735_Canvas::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+void ST7735_Canvas::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void ST7735_Canvas::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if(!_buf) return;
+  if(x < 0) { w += x; x = 0; }
+  if(y < 0) { h += y; y = 0; }
+  if(x + w > _width)  w = _width  - x;
+  if(y + h > _height) h = _height - y;
+  if((w <= 0) || (h <= 0)) return;
+
+  // a rectangle stays one under any quarter turn
+  int16_t x0 = x, y0 = y, x1 = x + w - 1, y1 = y + h - 1, t;
+  toRaw(x0, y0);
+  toRaw(x1, y1);
+  if(x0 > x1) { t = x0; x0 = x1; x1 = t; }
+  if(y0 > y1) { t = y0; y0 = y1; y1 = t; }
+
+  for(int16_t j = y0; j <= y1; j++) {
+    uint16_t *p = &_buf[j * WIDTH + x0];
+    for(int16_t i = x0; i <= x1; i++) *p++ = color;
+  }
+  addDirty(x0, y0, x1, y1);
+}
+
+void ST7735_Canvas::fillScreen(uint16_t color) {
+  fillRect(0, 0, _width, _height, color);
+}
+
+// Add a region and merge it with anything it overlaps or touches, so a
+// run of drawPixel() calls along a line collapses into one rectangle.
+// When the list is full the pair whose union grows the least is merged.
+void ST7735_Canvas::addDirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  // common case: still inside the last region touched
+  if(_nDirty) {
+    Rect &l = _dirty[_nDirty - 1];
+    if((x0 >= l.x0) && (x1 <= l.x1) && (y0 >= l.y0) && (y1 <= l.y1)) return;
+  }
+
+  Rect r = { x0, y0, x1, y1 };
+  boolean merged;
+  do {
+    merged = false;
+    for(uint8_t i = 0; i < _nDirty; i++) {
+      Rect &d = _dirty[i];
+      if((r.x0 <= d.x1 + 1) && (d.x0 <= r.x1 + 1) &&
+         (r.y0 <= d.y1 + 1) && (d.y0 <= r.y1 + 1)) {
+        r = unite(d, r);
+        _dirty[i] = _dirty[--_nDirty];
+        merged = true;
+        break;
+      }
+    }
+  } while(merged);
+
+  if(_nDirty == ST7735_CANVAS_DIRTY) {
+    uint8_t  best = 0;
+    uint32_t bestGrowth = 0xFFFFFFFF;
+    for(uint8_t i = 0; i < _nDirty; i++) {
+      Rect &d = _dirty[i];
+      uint32_t growth = area(unite(d, r)) - area(d);
+      if(growth < bestGrowth) {
+        bestGrowth = growth;
+        best = i;
+      }
+    }
+    Rect u = unite(_dirty[best], r);
+    _dirty[best] = _dirty[--_nDirty];
+    addDirty(u.x0, u.y0, u.x1, u.y1);
+    return;
+  }
+  _dirty[_nDirty++] = r;
+}
+
+// Send buffer rectangle r, as the canvas sees it with its origin at
+// (x, y) on the panel.  Unrotated, rows go straight out of the buffer;
+// turned, each panel row is gathered from a buffer column.
+template<class Display>
+void ST7735_Canvas::send(Display &tft, Rect r, int16_t x, int16_t y) {
+  int16_t t;
+  toLogical(r.x0, r.y0);
+  toLogical(r.x1, r.y1);
+  if(r.x0 > r.x1) { t = r.x0; r.x0 = r.x1; r.x1 = t; }
+  if(r.y0 > r.y1) { t = r.y0; r.y0 = r.y1; r.y1 = t; }
+
+  // clip to the panel
+  int16_t x0 = r.x0 + x, y0 = r.y0 + y, x1 = r.x1 + x, y1 = r.y1 + y;
+  if(x0 < 0) x0 = 0;
+  if(y0 < 0) y0 = 0;
+  if(x1 >= tft.width())  x1 = tft.width()  - 1;
+  if(y1 >= tft.height()) y1 = tft.height() - 1;
+  if((x0 > x1) || (y0 > y1)) return;
+
+  uint16_t w = x1 - x0 + 1;
+  tft.startDraw(x0, y0, x1, y1);
+  for(int16_t j = y0; j <= y1; j++) {
+    if(!rotation) {
+      tft.pushColors(&_buf[(j - y) * WIDTH + (x0 - x)], w);
+      continue;
+    }
+    uint16_t line[ST7735_PUSH_CHUNK/2];
+    uint8_t  k = 0;
+    for(int16_t i = x0; i <= x1; i++) {
+      int16_t bx = i - x, by = j - y;
+      toRaw(bx, by);
+      line[k++] = _buf[by * WIDTH + bx];
+      if(k == ST7735_PUSH_CHUNK/2) {
+        tft.pushColors(line, k);
+        k = 0;
+      }
+    }
+    if(k) tft.pushColors(line, k);
+  }
+  tft.endDraw();
+}
+
+// Send every dirty region to the panel, canvas origin at (x, y), in one
+// bus transaction.  With a valid shadow only the pixels that differ go
+// out: each row of a region is split into its changed spans, unchanged
+// stretches shorter than ST7735_CANVAS_GAP are sent along with them.
+template<class Display>
+void ST7735_Canvas::flush(Display &tft, int16_t x, int16_t y) {
+  if(!_buf) return;
+  tft.startWrite();
+  for(uint8_t i = 0; i < _nDirty; i++) {
+    Rect r = _dirty[i];
+    if(!_shadow || !_shadowValid) {
+      if(_shadow) {
+        for(int16_t j = r.y0; j <= r.y1; j++)
+          memcpy(&_shadow[j * WIDTH + r.x0], &_buf[j * WIDTH + r.x0], (r.x1 - r.x0 + 1) * 2);
+      }
+      send(tft, r, x, y);
+      continue;
+    }
+
+    for(int16_t j = r.y0; j <= r.y1; j++) {
+      uint16_t *p = &_buf[j * WIDTH];
+      uint16_t *s = &_shadow[j * WIDTH];
+      int16_t first = -1, last = -1;
+      for(int16_t k = r.x0; k <= r.x1 + 1; k++) {
+        boolean changed = (k <= r.x1) && (p[k] != s[k]);
+        if(changed) {
+          s[k] = p[k];
+          if(first < 0) first = k;
+          last = k;
+        } else if((first >= 0) && ((k > r.x1) || (k - last > ST7735_CANVAS_GAP))) {
+          Rect span = { first, j, last, j };
+          send(tft, span, x, y);
+          first = -1;
+        }
+      }
+    }
+  }
+  tft.endWrite();
+  _nDirty = 0;
+  if(_shadow) _shadowValid = true;
+}
+
+template void ST7735_Canvas::flush(Adafruit_ST7735 &, int16_t, int16_t);
+template void ST7735_Canvas::flush(Adafruit_ST7735_SW &, int16_t, int16_t);
@@ -0,0 +1,67 @@
+// Off-screen RGB565 canvas for the ST7735 with dirty-rectangle tracking.
+// Draw into RAM with the usual Adafruit_GFX calls, then flush() sends only
+// the merged regions that changed, each as one address window plus a bulk
+// pixel transfer.  A full 128x160 canvas needs 40K of RAM (80K with the
+// shadow copy), so this is for the ARM boards.
+
+#ifndef _ST7735_CANVAS_H_
+#define _ST7735_CANVAS_H_
+
+#include "Adafruit_ST7735.h"
+
+// dirty rectangles kept before the closest pair gets merged
+#define ST7735_CANVAS_DIRTY 8
+// unchanged pixels between two changed spans of a row that are sent
+// anyway rather than set up a second window (about one window's bytes)
+#define ST7735_CANVAS_GAP 6
+
+class ST7735_Canvas : public Adafruit_GFX {
+
+ public:
+
+  ST7735_Canvas(int16_t w = ST7735_TFTWIDTH_128, int16_t h = ST7735_TFTHEIGHT_160);
+  ~ST7735_Canvas(void);
+
+  // Allocate the framebuffer.  With shadow, a copy of what the panel shows
+  // is kept too and flush() only sends the spans of each row that changed.
+  // The buffer is kept unrotated like GFXcanvas16; setRotation() turns
+  // the drawing coordinates, flush() sends the canvas as it is seen.
+  boolean  begin(boolean shadow = false);
+
+  void     drawPixel(int16_t x, int16_t y, uint16_t color),
+           drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color),
+           drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color),
+           fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
+           fillScreen(uint16_t color);
+
+  // Display is Adafruit_ST7735 or Adafruit_ST7735_SW.
+  template<class Display>
+  void     flush(Display &tft, int16_t x = 0, int16_t y = 0);
+  void     invalidate(void); // next flush sends everything, e.g. after the panel was drawn over
+
+  uint16_t *getBuffer(void) { return _buf; }
+
+ private:
+  struct Rect { int16_t x0, y0, x1, y1; }; // inclusive
+
+  void     addDirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1),
+           toRaw(int16_t &x, int16_t &y),
+           toLogical(int16_t &x, int16_t &y);
+  template<class Display>
+  void     send(Display &tft, Rect r, int16_t x, int16_t y);
+  static Rect unite(const Rect &a, const Rect &b) {
+    Rect u = { a.x0 < b.x0 ? a.x0 : b.x0, a.y0 < b.y0 ? a.y0 : b.y0,
+               a.x1 > b.x1 ? a.x1 : b.x1, a.y1 > b.y1 ? a.y1 : b.y1 };
+    return u;
+  }
+  static uint32_t area(const Rect &r) {
+    return (uint32_t)(r.x1 - r.x0 + 1) * (r.y1 - r.y0 + 1);
+  }
+
+  uint16_t *_buf, *_shadow;
+  boolean   _shadowValid;
+  Rect      _dirty[ST7735_CANVAS_DIRTY];
+  uint8_t   _nDirty;
+};
+
+#endif
@@ -0,0 +1,90 @@
+// Scrolling text console, see ST7735_Console.h
+
+#include "ST7735_Console.h"
+#include <stdlib.h>
+
+template<class Display>
+ST7735_ConsoleT<Display>::ST7735_ConsoleT(Display &tft, uint8_t top, uint8_t lines)
+  : _tft(tft), _text(NULL), _top(top), _lines(lines), _cols(0),
+    _head(0), _row(0), _col(0) {
+}
+
+template<class Display>
+ST7735_ConsoleT<Display>::~ST7735_ConsoleT(void) {
+  free(_text);
+}
+
+template<class Display>
+boolean ST7735_ConsoleT<Display>::begin(void) {
+  _cols = _tft.width() / FONT_TILESZ;
+  free(_text);
+  _text = (char *)malloc(_lines * _cols);
+  if(!_text) return false;
+  _tft.setScrollArea(_top, _lines * FONT_TILESZ);
+  clear();
+  return true;
+}
+
+template<class Display>
+void ST7735_ConsoleT<Display>::clear(void) {
+  if(!_text) return;
+  memset(_text, ' ', _lines * _cols);
+  _head = _row = _col = 0;
+  _tft.scrollTo(0);
+  // the font's blank tile is all foreground, match it
+  _tft.fillRect(0, _top, _cols * FONT_TILESZ, _lines * FONT_TILESZ,
+    pgm_read_word(&fontCol[0]));
+}
+
+template<class Display>
+void ST7735_ConsoleT<Display>::redraw(void) {
+  if(!_text) return;
+  for(uint8_t slot = 0; slot < _lines; slot++) drawLine(slot);
+}
+
+template<class Display>
+size_t ST7735_ConsoleT<Display>::write(uint8_t c) {
+  if(!_text) return 0;
+  if(c == '\r') return 1;
+  if(c == '\n') {
+    newLine();
+    return 1;
+  }
+  if(_col >= _cols) newLine();
+
+  uint8_t slot = (_head + _row) % _lines;
+  _text[slot * _cols + _col] = c;
+  char glyph[2] = { (char)c, 0 };
+  _tft.drawFont(_col * FONT_TILESZ, slotY(slot), glyph);
+  _col++;
+  return 1;
+}
+
+// Move the cursor down.  Once the area is full the oldest slot is reused:
+// it is blanked, then the scroll start moves one line so it shows up at
+// the bottom.  Nothing else gets redrawn.
+template<class Display>
+void ST7735_ConsoleT<Display>::newLine(void) {
+  _col = 0;
+  if(_row < _lines - 1) {
+    _row++;
+    return;
+  }
+  uint8_t slot = _head;
+  _head = (_head + 1) % _lines;
+  memset(&_text[slot * _cols], ' ', _cols);
+  _tft.fillRect(0, slotY(slot), _cols * FONT_TILESZ, FONT_TILESZ,
+    pgm_read_word(&fontCol[0]));
+  _tft.scrollTo(_head * FONT_TILESZ);
+}
+
+template<class Display>
+void ST7735_ConsoleT<Display>::drawLine(uint8_t slot) {
+  char line[ST7735_TFTHEIGHT_160 / FONT_TILESZ + 1];
+  memcpy(line, &_text[slot * _cols], _cols);
+  line[_cols] = 0;
+  _tft.drawFont(0, slotY(slot), line);
+}
+
+template class ST7735_ConsoleT<Adafruit_ST7735>;
+template class ST7735_ConsoleT<Adafruit_ST7735_SW>;
@@ -0,0 +1,42 @@
+// Scrolling text console for the ST7735, built on the hardware vertical
+// scroll.  Adding a line moves the scroll start and draws only the line
+// that becomes visible, instead of redrawing the whole screen.
+// Glyphs come from the tileFont set used by drawFont().
+
+#ifndef _ST7735_CONSOLE_H_
+#define _ST7735_CONSOLE_H_
+
+#include "Adafruit_ST7735.h"
+
+template<class Display>
+class ST7735_ConsoleT : public Print {
+
+ public:
+
+  // Console over logical rows [top, top + lines*FONT_TILESZ).
+  // Needs rotation 0 or 2, where the scroll direction is vertical.
+  ST7735_ConsoleT(Display &tft, uint8_t top, uint8_t lines);
+  ~ST7735_ConsoleT(void);
+
+  boolean  begin(void);          // allocate the text ring, set scroll area
+  void     clear(void),
+           redraw(void);         // repaint every line from the ring
+  size_t   write(uint8_t c);     // '\n' starts a new line, '\r' ignored
+  using    Print::write;
+
+ private:
+  void     newLine(void),
+           drawLine(uint8_t slot);
+  uint8_t  slotY(uint8_t slot) { return _top + slot * FONT_TILESZ; }
+
+  Display &_tft;
+  char    *_text;               // lines x cols, one row per ring slot
+  uint8_t  _top, _lines, _cols;
+  uint8_t  _head;               // slot shown at the top of the area
+  uint8_t  _row, _col;          // cursor, _row counted from _head
+};
+
+// over the hardware SPI driver; ST7735_ConsoleT<Adafruit_ST7735_SW> for software SPI
+typedef ST7735_ConsoleT<Adafruit_ST7735> ST7735_Console;
+
+#endif
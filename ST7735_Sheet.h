@@ -0,0 +1,168 @@
+/***************************************************
+  Compile-time sprite sheet encoder for the ST7735 driver.
+
+  Write the sheet as raw palette indices, one per pixel, laid out as the
+  image (imageW x imageH, tiles left to right then top to bottom):
+
+    ST7735_SHEET(hero, 16, 8, 8, 8, 4,
+      0,0,1,1,1,1,0,0, 0,0,2,2,2,2,0,0,
+      ...);
+
+    tft.drawCBMPsectionRLE(x, y, 8, 8, hero::rle(), hero::tileAddr(), pal, 8, 8, tile, false, false);
+    tft.drawCBMPsection(x, y, 8, 8, hero::packed(), pal, 16, 8, tile, false, false, ST7735_PACKED4);
+
+  The encoders run in constexpr functions, so only the arrays that are
+  used get emitted to PROGMEM and the raw indices never reach the target.
+  rle() is the V1 format with its tileAddr() table, packed() the 4bpp
+  image drawCBMPsection() reads.  The static_asserts reject index data
+  that does not fill the image, tiles that do not divide it, and indices
+  past the palette.
+
+  C++11 constexpr evaluation is recursive: walking a tile nests one call
+  per pixel, which has to stay under the compiler's constexpr depth (512
+  by default), so tiles are limited to ST7735_SHEET_DEPTH pixels.  Bigger
+  tiles, or the V2/V3 formats, belong in extras/assetc.
+ ****************************************************/
+
+#ifndef _ST7735_SHEET_H_
+#define _ST7735_SHEET_H_
+
+#include "Adafruit_ST7735.h"
+
+// stay clear of GCC's default -fconstexpr-depth=512
+#define ST7735_SHEET_DEPTH 480
+
+#define ST7735_SHEET(name, imageW, imageH, tileW, tileH, colours, ...) \
+  struct name##_src { \
+    static constexpr uint8_t W = imageW, H = imageH, TW = tileW, TH = tileH; \
+    static constexpr uint8_t COLOURS = colours; \
+    static constexpr uint8_t px[] = { __VA_ARGS__ }; \
+    static constexpr uint16_t COUNT = sizeof(px); \
+  }; \
+  typedef ST7735_Sheet<name##_src> name
+
+// 0, 1, ... N-1 as a parameter pack, built by halves so the template
+// nesting only grows with log N
+template<uint16_t... I> struct ST7735_Seq {};
+
+template<class A, class B> struct ST7735_SeqCat;
+template<uint16_t... A, uint16_t... B>
+struct ST7735_SeqCat<ST7735_Seq<A...>, ST7735_Seq<B...> > {
+  typedef ST7735_Seq<A..., (uint16_t)(sizeof...(A) + B)...> type;
+};
+
+template<uint16_t N> struct ST7735_MakeSeq {
+  typedef typename ST7735_SeqCat<typename ST7735_MakeSeq<N / 2>::type,
+                                 typename ST7735_MakeSeq<N - N / 2>::type>::type type;
+};
+template<> struct ST7735_MakeSeq<0> { typedef ST7735_Seq<> type; };
+template<> struct ST7735_MakeSeq<1> { typedef ST7735_Seq<0> type; };
+
+// PROGMEM arrays filled from a sheet's encoder, one element per index
+template<class Sheet, class Seq> struct ST7735_SheetRLE;
+template<class Sheet, uint16_t... I> struct ST7735_SheetRLE<Sheet, ST7735_Seq<I...> > {
+  static const uint8_t data[sizeof...(I)];
+};
+template<class Sheet, uint16_t... I>
+const uint8_t ST7735_SheetRLE<Sheet, ST7735_Seq<I...> >::data[sizeof...(I)] PROGMEM = { Sheet::rleByte(I)... };
+
+template<class Sheet, class Seq> struct ST7735_SheetAddr;
+template<class Sheet, uint16_t... I> struct ST7735_SheetAddr<Sheet, ST7735_Seq<I...> > {
+  static const uint16_t data[sizeof...(I)];
+};
+template<class Sheet, uint16_t... I>
+const uint16_t ST7735_SheetAddr<Sheet, ST7735_Seq<I...> >::data[sizeof...(I)] PROGMEM = { Sheet::addrEntry(I)... };
+
+template<class Sheet, class Seq> struct ST7735_SheetPacked;
+template<class Sheet, uint16_t... I> struct ST7735_SheetPacked<Sheet, ST7735_Seq<I...> > {
+  static const uint8_t data[sizeof...(I)];
+};
+template<class Sheet, uint16_t... I>
+const uint8_t ST7735_SheetPacked<Sheet, ST7735_Seq<I...> >::data[sizeof...(I)] PROGMEM = { Sheet::packByte(I)... };
+
+// start of each tile's RLE stream.  Template instances are only built
+// once, unlike constexpr calls which the compiler may re-evaluate for
+// every byte that needs them.
+template<class Sheet, uint16_t T> struct ST7735_SheetOffset {
+  static constexpr uint16_t value = ST7735_SheetOffset<Sheet, T - 1>::value + Sheet::tileBytes(T - 1);
+};
+template<class Sheet> struct ST7735_SheetOffset<Sheet, 0> {
+  static constexpr uint16_t value = 0;
+};
+
+template<class Sheet, class Seq> struct ST7735_SheetOffsets;
+template<class Sheet, uint16_t... I> struct ST7735_SheetOffsets<Sheet, ST7735_Seq<I...> > {
+  static constexpr uint16_t data[sizeof...(I)] = { ST7735_SheetOffset<Sheet, I>::value... };
+};
+template<class Sheet, uint16_t... I>
+constexpr uint16_t ST7735_SheetOffsets<Sheet, ST7735_Seq<I...> >::data[sizeof...(I)];
+
+template<class Src> struct ST7735_Sheet {
+  static constexpr uint8_t  W = Src::W, H = Src::H, TW = Src::TW, TH = Src::TH;
+  static constexpr uint16_t TILES  = (uint16_t)(W / TW) * (H / TH);
+  static constexpr uint16_t TILEPX = (uint16_t)TW * TH;
+  static constexpr uint16_t ROWBYTES = (W + 1) / 2;
+
+  // largest index in px[lo, hi), split in halves to keep the depth down
+  static constexpr uint8_t larger(uint8_t a, uint8_t b) { return a > b ? a : b; }
+  static constexpr uint8_t maxIndex(uint16_t lo, uint16_t hi) {
+    return (hi - lo == 1) ? Src::px[lo] : larger(maxIndex(lo, (lo + hi) / 2), maxIndex((lo + hi) / 2, hi));
+  }
+
+  static_assert(Src::COUNT == (uint16_t)W * H, "ST7735_SHEET: index count does not match imageW x imageH");
+  static_assert(TW && TH && (W % TW == 0) && (H % TH == 0), "ST7735_SHEET: tiles do not divide the image");
+  static_assert(TILES <= 255, "ST7735_SHEET: more than 255 tiles");
+  static_assert(Src::COLOURS <= 16, "ST7735_SHEET: more than 16 colours");
+  static_assert(maxIndex(0, Src::COUNT) < Src::COLOURS, "ST7735_SHEET: index past the end of the palette");
+  static_assert(TILEPX <= ST7735_SHEET_DEPTH, "ST7735_SHEET: tile too large to encode at compile time");
+
+  // pixel p of tile t, addressed like Adafruit_ST7735::tileOffset()
+  static constexpr uint8_t pix(uint16_t t, uint16_t p) {
+    return Src::px[((t * TW) % W) + (uint16_t)TH * ((t * TW) / W) * W + (p / TW) * W + p % TW];
+  }
+
+  // V1 run at pixel p of tile t: at most 16 pixels and never past the tile
+  static constexpr uint8_t run(uint16_t t, uint16_t p, uint8_t n = 1) {
+    return (n < 16 && p + n < TILEPX && pix(t, p + n) == pix(t, p)) ? run(t, p, n + 1) : n;
+  }
+  static constexpr uint16_t tileBytes(uint16_t t, uint16_t p = 0) {
+    return (p >= TILEPX) ? 0 : 1 + tileBytes(t, p + run(t, p));
+  }
+  // byte k of tile t's stream, walking runs from pixel p
+  static constexpr uint8_t tileByte(uint16_t t, uint16_t k, uint16_t p = 0) {
+    return k ? tileByte(t, k - 1, p + run(t, p)) : (uint8_t)((pix(t, p) << 4) | (run(t, p) - 1));
+  }
+  static constexpr uint16_t offset(uint16_t t) {
+    return ST7735_SheetOffsets<ST7735_Sheet, typename ST7735_MakeSeq<TILES + 1>::type>::data[t];
+  }
+  // tile holding stream byte k: the last t in [lo, hi) with offset(t) <= k
+  static constexpr uint16_t tileOf(uint16_t k, uint16_t lo = 0, uint16_t hi = TILES) {
+    return (hi - lo == 1) ? lo
+      : (offset((lo + hi) / 2) <= k ? tileOf(k, (lo + hi) / 2, hi) : tileOf(k, lo, (lo + hi) / 2));
+  }
+  static constexpr uint8_t rleByte(uint16_t k) {
+    return tileByte(tileOf(k), k - offset(tileOf(k)));
+  }
+  static constexpr uint16_t addrEntry(uint16_t i) {
+    return i ? offset(i - 1) : (ST7735_RLE_V1 << 8) | TILES;
+  }
+  // 4bpp, high nibble first, rows padded to a whole byte
+  static constexpr uint8_t packByte(uint16_t k) {
+    return (uint8_t)((Src::px[(k / ROWBYTES) * W + (k % ROWBYTES) * 2] << 4)
+      | (((k % ROWBYTES) * 2 + 1 < W) ? Src::px[(k / ROWBYTES) * W + (k % ROWBYTES) * 2 + 1] : 0));
+  }
+
+  static constexpr uint16_t RLE_BYTES = offset(TILES);
+
+  static const uint8_t *rle(void) {
+    return ST7735_SheetRLE<ST7735_Sheet, typename ST7735_MakeSeq<RLE_BYTES>::type>::data;
+  }
+  static const uint16_t *tileAddr(void) {
+    return ST7735_SheetAddr<ST7735_Sheet, typename ST7735_MakeSeq<TILES + 1>::type>::data;
+  }
+  static const uint8_t *packed(void) {
+    return ST7735_SheetPacked<ST7735_Sheet, typename ST7735_MakeSeq<ROWBYTES * H>::type>::data;
+  }
+};
+
+#endif
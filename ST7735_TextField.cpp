@@ -0,0 +1,70 @@
+// Diffing text field, see ST7735_TextField.h
+
+#include "ST7735_TextField.h"
+#include <stdlib.h>
+
+template<class Display>
+ST7735_TextFieldT<Display>::ST7735_TextFieldT(Display &tft, int16_t x, int16_t y, uint8_t cols)
+  : _tft(tft), _shown(NULL), _x(x), _y(y), _cols(cols),
+    _set(pgm_read_word(&fontCol[0])), _clear(pgm_read_word(&fontCol[1])),
+    _all(true) {
+}
+
+template<class Display>
+ST7735_TextFieldT<Display>::~ST7735_TextFieldT(void) {
+  free(_shown);
+}
+
+template<class Display>
+boolean ST7735_TextFieldT<Display>::begin(void) {
+  free(_shown);
+  _shown = (char *)malloc(_cols + 1);
+  _all = true;
+  return _shown != NULL;
+}
+
+template<class Display>
+void ST7735_TextFieldT<Display>::setColors(uint16_t set, uint16_t clear) {
+  _set = set;
+  _clear = clear;
+  _all = true;
+}
+
+template<class Display>
+void ST7735_TextFieldT<Display>::invalidate(void) {
+  _all = true;
+}
+
+template<class Display>
+void ST7735_TextFieldT<Display>::update(String text) {
+  update(text.c_str());
+}
+
+// Walk the cells once.  Each run of changed cells is copied into _shown
+// and drawn straight from there, terminated for the moment by the cell
+// after it.
+template<class Display>
+void ST7735_TextFieldT<Display>::update(const char *text) {
+  if(!_shown) return;
+  uint8_t start = 0; // first cell of the current run
+  for(uint8_t i = 0; i <= _cols; i++) {
+    boolean changed = false;
+    if(i < _cols) {
+      char c = *text ? *text++ : ' ';
+      changed = _all || (_shown[i] != c);
+      _shown[i] = c;
+    }
+    if(changed) continue;
+    if(i > start) {
+      char keep = _shown[i];
+      _shown[i] = 0;
+      _tft.drawFont(_x + start * FONT_TILESZ, _y, &_shown[start], _set, _clear);
+      _shown[i] = keep;
+    }
+    start = i + 1;
+  }
+  _all = false;
+}
+
+template class ST7735_TextFieldT<Adafruit_ST7735>;
+template class ST7735_TextFieldT<Adafruit_ST7735_SW>;
@@ -0,0 +1,38 @@
+// Fixed-width text field for the ST7735.  Remembers the string it last
+// drew and update() redraws only the glyph cells that changed; changed
+// cells next to each other go out in one drawFont() window.
+// Glyphs come from the tileFont set used by drawFont().
+
+#ifndef _ST7735_TEXTFIELD_H_
+#define _ST7735_TEXTFIELD_H_
+
+#include "Adafruit_ST7735.h"
+
+template<class Display>
+class ST7735_TextFieldT {
+
+ public:
+
+  // cols glyph cells, FONT_TILESZ apart, starting at (x, y)
+  ST7735_TextFieldT(Display &tft, int16_t x, int16_t y, uint8_t cols);
+  ~ST7735_TextFieldT(void);
+
+  boolean  begin(void);          // allocate the shown text
+  void     setColors(uint16_t set, uint16_t clear), // as drawFont(), default fontCol
+           invalidate(void),     // panel contents unknown, redraw every cell
+           update(const char *text), // shorter text is blanked out, longer cut off
+           update(String text);
+
+ private:
+  Display &_tft;
+  char    *_shown;               // cols chars, what the panel shows
+  int16_t  _x, _y;
+  uint8_t  _cols;
+  uint16_t _set, _clear;
+  boolean  _all;
+};
+
+// over the hardware SPI driver; ST7735_TextFieldT<Adafruit_ST7735_SW> for software SPI
+typedef ST7735_TextFieldT<Adafruit_ST7735> ST7735_TextField;
+
+#endif
@@ -0,0 +1,189 @@
+// Incremental tilemap renderer, see ST7735_Tilemap.h
+
+#include "ST7735_Tilemap.h"
+#include <stdlib.h>
+
+template<class Display>
+ST7735_TilemapT<Display>::ST7735_TilemapT(Display &tft, uint8_t cols, uint8_t rows, uint8_t tileW, uint8_t tileH)
+  : _tft(tft), _cells(NULL), _shown(NULL), _cols(cols), _rows(rows),
+    _tileW(tileW), _tileH(tileH), _x(0), _y(0), _all(true),
+    _colorIndex(NULL), _tileAddr(NULL), _pal(NULL), _imageW(0) {
+}
+
+template<class Display>
+ST7735_TilemapT<Display>::~ST7735_TilemapT(void) {
+  free(_cells);
+  free(_shown);
+}
+
+template<class Display>
+boolean ST7735_TilemapT<Display>::begin(void) {
+  uint16_t n = (uint16_t)_cols * _rows;
+  free(_cells);
+  free(_shown);
+  _cells = (uint8_t *)calloc(n, 1);
+  _shown = (uint8_t *)calloc(n, 1);
+  _all = true;
+  return _cells && _shown;
+}
+
+template<class Display>
+void ST7735_TilemapT<Display>::setSheet(const uint8_t colorIndex[], const uint16_t pal[], uint8_t imageW) {
+  _colorIndex = colorIndex;
+  _tileAddr = NULL;
+  _pal = pal;
+  _imageW = imageW;
+  _all = true;
+}
+
+template<class Display>
+void ST7735_TilemapT<Display>::setSheetRLE(const uint8_t colorIndex[], const uint16_t tileAddr[], const uint16_t pal[]) {
+  _colorIndex = colorIndex;
+  _tileAddr = tileAddr;
+  _pal = pal;
+  _all = true;
+}
+
+template<class Display>
+void ST7735_TilemapT<Display>::setTile(uint8_t col, uint8_t row, uint8_t tile) {
+  if(_cells && (col < _cols) && (row < _rows)) _cells[row * _cols + col] = tile;
+}
+
+template<class Display>
+uint8_t ST7735_TilemapT<Display>::getTile(uint8_t col, uint8_t row) {
+  if(_cells && (col < _cols) && (row < _rows)) return _cells[row * _cols + col];
+  return 0;
+}
+
+template<class Display>
+void ST7735_TilemapT<Display>::fill(uint8_t tile) {
+  if(_cells) memset(_cells, tile, (uint16_t)_cols * _rows);
+}
+
+template<class Display>
+void ST7735_TilemapT<Display>::invalidate(void) {
+  _all = true;
+}
+
+template<class Display>
+void ST7735_TilemapT<Display>::render(int16_t x, int16_t y) {
+  if(!_cells || !_colorIndex) return;
+  _x = x;
+  _y = y;
+
+  for(uint8_t r = 0; r < _rows; r++) {
+    uint8_t *cells = &_cells[r * _cols];
+    uint8_t *shown = &_shown[r * _cols];
+    int16_t  ty = y + r * _tileH;
+    uint8_t  c = 0;
+    while(c < _cols) {
+      if(!_all && (cells[c] == shown[c])) {
+        c++;
+        continue;
+      }
+      // extend over the following changed cells
+      uint8_t start = c;
+      while((c < _cols) && (_all || (cells[c] != shown[c]))) {
+        shown[c] = cells[c];
+        c++;
+      }
+      int16_t tx = x + start * _tileW;
+      if(_tileAddr)
+        _tft.drawTilesRLE(tx, ty, _tileW, _tileH, &cells[start], c - start, _colorIndex, _tileAddr, _pal);
+      else
+        _tft.drawTiles(tx, ty, _tileW, _tileH, &cells[start], c - start, _colorIndex, _pal, _imageW);
+    }
+  }
+  _all = false;
+}
+
+template<class Display>
+void ST7735_TilemapT<Display>::drawSprite(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t mask[], const uint8_t colorIndex[], const uint16_t pal[]) {
+  compose(x, y, w, h, mask, colorIndex, pal);
+}
+
+template<class Display>
+void ST7735_TilemapT<Display>::restore(int16_t x, int16_t y, uint8_t w, uint8_t h) {
+  compose(x, y, w, h, NULL, NULL, NULL);
+}
+
+template<class Display>
+void ST7735_TilemapT<Display>::compose(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t mask[], const uint8_t colorIndex[], const uint16_t pal[]) {
+  if(!_cells || !_colorIndex) return;
+
+  // clip to the map and the screen
+  int16_t x0 = x, y0 = y, x1 = x + w, y1 = y + h;
+  if(x0 < _x) x0 = _x;
+  if(y0 < _y) y0 = _y;
+  if(x0 < 0)  x0 = 0;
+  if(y0 < 0)  y0 = 0;
+  if(x1 > _x + _cols * _tileW) x1 = _x + _cols * _tileW;
+  if(y1 > _y + _rows * _tileH) y1 = _y + _rows * _tileH;
+  if(x1 > _tft.width())  x1 = _tft.width();
+  if(y1 > _tft.height()) y1 = _tft.height();
+  if((x0 >= x1) || (y0 >= y1)) return;
+
+  uint16_t bgPal[16], spPal[16];
+  for(uint8_t i = 0; i < 16; i++) {
+    bgPal[i] = pgm_read_word(&_pal[i]);
+    if(pal) spPal[i] = pgm_read_word(&pal[i]);
+  }
+  uint8_t  maskW = (w + 7) / 8;
+  uint16_t line[ST7735_TFTHEIGHT_160];
+  ST7735_RLEState st[ST7735_MAX_TILE_RUN];
+
+  // tile columns under the box, each RLE one needs its own decoder, so a
+  // wider box goes out in windows of at most ST7735_MAX_TILE_RUN columns
+  uint8_t cFirst = (x0 - _x) / _tileW;
+  uint8_t cLast  = (x1 - 1 - _x) / _tileW;
+  for(uint16_t c0 = cFirst; c0 <= cLast; c0 += ST7735_MAX_TILE_RUN) {
+    uint8_t c1 = (cLast - c0 >= ST7735_MAX_TILE_RUN) ? c0 + ST7735_MAX_TILE_RUN - 1 : cLast;
+    int16_t wx0 = _x + c0 * _tileW, wx1 = _x + (c1 + 1) * _tileW;
+    if(wx0 < x0) wx0 = x0;
+    if(wx1 > x1) wx1 = x1;
+
+    _tft.startDraw(wx0, y0, wx1 - 1, y1 - 1);
+    for(int16_t py = y0; py < y1; py++) {
+      uint8_t  row = (py - _y) / _tileH;
+      uint8_t  ty  = (py - _y) % _tileH;
+      uint16_t *out = line;
+
+      // background
+      for(uint8_t c = c0; c <= c1; c++) {
+        uint8_t tile = _cells[row * _cols + c];
+        int16_t tx = _x + c * _tileW;
+        uint8_t a = (wx0 > tx) ? wx0 - tx : 0;                    // first column used
+        uint8_t b = (wx1 < tx + _tileW) ? wx1 - tx : _tileW;      // one past the last
+        if(_tileAddr) {
+          ST7735_RLEState &s = st[c - c0];
+          if((ty == 0) || (py == y0)) {
+            _tft.rleBegin(s, _colorIndex, _tileAddr, tile, _pal);
+            _tft.rleDecode(s, bgPal, NULL, (uint16_t)ty * _tileW);
+          }
+          _tft.rleDecode(s, bgPal, NULL, a);
+          _tft.rleDecode(s, bgPal, out, b - a);
+          _tft.rleDecode(s, bgPal, NULL, _tileW - b);
+        } else {
+          const uint8_t *src = &_colorIndex[Display::tileOffset(tile, _tileW, _tileH, _imageW) + (uint16_t)ty * _imageW];
+          for(uint8_t i = a; i < b; i++) out[i - a] = bgPal[pgm_read_byte(&src[i])];
+        }
+        out += b - a;
+      }
+
+      // sprite on top
+      if(mask) {
+        int16_t sy = py - y;
+        for(int16_t px = wx0; px < wx1; px++) {
+          int16_t sx = px - x;
+          if(pgm_read_byte(&mask[sy * maskW + sx / 8]) & (0x80 >> (sx & 7)))
+            line[px - wx0] = spPal[pgm_read_byte(&colorIndex[sy * w + sx])];
+        }
+      }
+      _tft.pushColors(line, wx1 - wx0);
+    }
+    _tft.endDraw();
+  }
+}
+
+template class ST7735_TilemapT<Adafruit_ST7735>;
+template class ST7735_TilemapT<Adafruit_ST7735_SW>;
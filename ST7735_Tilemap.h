@@ -0,0 +1,59 @@
+// Incremental tilemap for the ST7735.  Keeps the tile index of every cell
+// plus a shadow of what the panel currently shows; render() only redraws
+// cells whose index changed, and a run of changed cells in a row goes out
+// in one address window (per ST7735_MAX_TILE_RUN cells).
+
+#ifndef _ST7735_TILEMAP_H_
+#define _ST7735_TILEMAP_H_
+
+#include "Adafruit_ST7735.h"
+
+template<class Display>
+class ST7735_TilemapT {
+
+ public:
+
+  ST7735_TilemapT(Display &tft, uint8_t cols, uint8_t rows, uint8_t tileW, uint8_t tileH);
+  ~ST7735_TilemapT(void);
+
+  boolean  begin(void); // allocate cells and shadow
+
+  // Tile source: a 16 colour byte-per-pixel sheet (as drawCBMPsection
+  // bitDepth 4), or an RLE sheet with its tileAddr table.
+  void     setSheet(const uint8_t colorIndex[], const uint16_t pal[], uint8_t imageW),
+           setSheetRLE(const uint8_t colorIndex[], const uint16_t tileAddr[], const uint16_t pal[]);
+
+  void     setTile(uint8_t col, uint8_t row, uint8_t tile),
+           fill(uint8_t tile),
+           invalidate(void),                      // panel contents unknown, redraw everything
+           render(int16_t x = 0, int16_t y = 0);  // map origin on screen
+
+  // Transparent sprite over the map, composed a scanline at a time: the
+  // tiles underneath are decoded, pixels whose mask bit is set are laid on
+  // top, and the row goes out in the sprite's address window (one per
+  // ST7735_MAX_TILE_RUN tile columns).  mask is 1bpp with rows padded to
+  // whole bytes, colorIndex one byte per pixel into a 16 entry pal.  Uses
+  // the origin of the last render().
+  void     drawSprite(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t mask[], const uint8_t colorIndex[], const uint16_t pal[]),
+           restore(int16_t x, int16_t y, uint8_t w, uint8_t h); // background only, e.g. where a sprite was
+  uint8_t  getTile(uint8_t col, uint8_t row);
+
+ private:
+  Display &_tft;
+  uint8_t  *_cells, *_shown;
+  uint8_t   _cols, _rows, _tileW, _tileH;
+  int16_t   _x, _y;
+  boolean   _all;
+
+  const uint8_t  *_colorIndex;
+  const uint16_t *_tileAddr; // NULL for raw sheets
+  const uint16_t *_pal;
+  uint8_t         _imageW;
+
+  void     compose(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t mask[], const uint8_t colorIndex[], const uint16_t pal[]);
+};
+
+// over the hardware SPI driver; ST7735_TilemapT<Adafruit_ST7735_SW> for software SPI
+typedef ST7735_TilemapT<Adafruit_ST7735> ST7735_Tilemap;
+
+#endif
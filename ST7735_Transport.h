@@ -0,0 +1,225 @@
+// Bus transports for Adafruit_ST7735T<Transport>.
+//
+// The driver is generic over one of these, so hardware vs software SPI
+// and the per-board bus setup are settled when the sketch is compiled and
+// nothing is decided per byte.  Every transport has:
+//
+//   void init(void);                         pins and bus setup, from initR()/initB()
+//   void begin(void), end(void);             around each CS frame
+//   void write(uint8_t c);                   one byte
+//   void writeBuf(uint8_t *buf, uint16_t n); n bytes, buf may be overwritten
+//   void writeRepeat16(uint16_t c, uint32_t n); the 16-bit word c, n times
+//
+// ST7735_HwSPI is the hardware SPI transport for the board being built,
+// ST7735_SwSPI bit-bangs any two pins, and host builds (ST7735_HOST, see
+// extras/host) get ST7735_CaptureSPI, which records the bytes instead.
+
+#ifndef _ST7735_TRANSPORT_H_
+#define _ST7735_TRANSPORT_H_
+
+#include "Arduino.h"
+#include <SPI.h>
+
+#if defined(ST7735_HOST)
+  #include <vector>
+#endif
+
+// bytes of stack scratch used by the bulk pixel writers (must be even)
+#define ST7735_PUSH_CHUNK 32
+
+// writeRepeat16() for the transports that take whole buffers.  The buffer
+// is refilled for every chunk as the transfer may overwrite it.
+template<class Bus>
+inline void ST7735_bufRepeat16(Bus &bus, uint16_t c, uint32_t n)
+{
+  uint8_t buf[ST7735_PUSH_CHUNK];
+  uint8_t hi = c >> 8, lo = c;
+  while(n)
+  {
+    uint8_t k = 0;
+    while(n && k < ST7735_PUSH_CHUNK)
+    {
+      buf[k++] = hi;
+      buf[k++] = lo;
+      n--;
+    }
+    bus.writeBuf(buf, k);
+  }
+}
+
+#if defined (SPI_HAS_TRANSACTION)
+// Hardware SPI through the SPI library, configured once per transaction.
+class ST7735_TransactionSPI {
+ public:
+  void init(void) {
+    SPI.begin();
+    _settings = SPISettings(16000000, MSBFIRST, SPI_MODE0);
+  }
+  inline void begin(void) { SPI.beginTransaction(_settings); }
+  inline void end(void)   { SPI.endTransaction(); }
+  inline void write(uint8_t c) { SPI.transfer(c); }
+  inline void writeBuf(uint8_t *buf, uint16_t n) { SPI.transfer(buf, n); }
+  void writeRepeat16(uint16_t c, uint32_t n) { ST7735_bufRepeat16(*this, c, n); }
+ private:
+  SPISettings _settings;
+};
+#endif
+
+#if defined (SPI_HAS_TRANSACTION) && defined (__AVR__)
+// AVR: straight to the data register, the next byte is loaded as soon as
+// the current one has gone.
+class ST7735_AvrSPI : public ST7735_TransactionSPI {
+ public:
+  inline void write(uint8_t c) {
+    SPDR = c;
+    while(!(SPSR & _BV(SPIF)));
+  }
+  inline void writeBuf(uint8_t *buf, uint16_t n) {
+    if(!n) return;
+    SPDR = *buf++;
+    while(--n) {
+      uint8_t c = *buf++;
+      while(!(SPSR & _BV(SPIF)));
+      SPDR = c;
+    }
+    while(!(SPSR & _BV(SPIF)));
+  }
+  void writeRepeat16(uint16_t c, uint32_t n) { ST7735_bufRepeat16(*this, c, n); }
+};
+#endif
+
+#if !defined (SPI_HAS_TRANSACTION) && (defined (__AVR__) || defined(CORE_TEENSY))
+// Older AVR cores: our SPCR is swapped in for the length of a frame.
+class ST7735_SpcrSPI {
+ public:
+  void init(void) {
+    SPI.begin();
+    SPI.setClockDivider(SPI_CLOCK_DIV2); // 8 MHz (full! speed!)
+    SPI.setDataMode(SPI_MODE0);
+    _spcr = SPCR;
+  }
+  inline void begin(void) { _saved = SPCR; SPCR = _spcr; }
+  inline void end(void)   { SPCR = _saved; }
+  inline void write(uint8_t c) { SPI.transfer(c); }
+  inline void writeBuf(uint8_t *buf, uint16_t n) { while(n--) SPI.transfer(*buf++); }
+  void writeRepeat16(uint16_t c, uint32_t n) { ST7735_bufRepeat16(*this, c, n); }
+ private:
+  uint8_t _spcr, _saved;
+};
+#endif
+
+#if !defined (SPI_HAS_TRANSACTION) && defined (__arm__)
+// Older ARM cores without transactions.
+class ST7735_ArmSPI {
+ public:
+  void init(void) { SPI.begin(); }
+  inline void begin(void) {
+    SPI.setClockDivider(21); //4MHz
+    SPI.setDataMode(SPI_MODE0);
+  }
+  inline void end(void) { }
+  inline void write(uint8_t c) { SPI.transfer(c); }
+  inline void writeBuf(uint8_t *buf, uint16_t n) { while(n--) SPI.transfer(*buf++); }
+  void writeRepeat16(uint16_t c, uint32_t n) { ST7735_bufRepeat16(*this, c, n); }
+};
+#endif
+
+// Any other core: plain SPI.transfer() at whatever the bus is set to.
+class ST7735_PlainSPI {
+ public:
+  void init(void) { SPI.begin(); }
+  inline void begin(void) { }
+  inline void end(void) { }
+  inline void write(uint8_t c) { SPI.transfer(c); }
+  inline void writeBuf(uint8_t *buf, uint16_t n) { while(n--) SPI.transfer(*buf++); }
+  void writeRepeat16(uint16_t c, uint32_t n) { ST7735_bufRepeat16(*this, c, n); }
+};
+
+#if defined (SPI_HAS_TRANSACTION) && defined (__AVR__)
+  typedef ST7735_AvrSPI ST7735_HwSPI;
+#elif defined (SPI_HAS_TRANSACTION)
+  typedef ST7735_TransactionSPI ST7735_HwSPI;
+#elif defined (__AVR__) || defined(CORE_TEENSY)
+  typedef ST7735_SpcrSPI ST7735_HwSPI;
+#elif defined (__arm__)
+  typedef ST7735_ArmSPI ST7735_HwSPI;
+#else
+  typedef ST7735_PlainSPI ST7735_HwSPI;
+#endif
+
+// Bit-banged SPI, mode 0, MSB first, on any two pins, which leaves the
+// hardware SPI pins free for e.g. an SD card.  Unrolled on the port
+// registers where USE_FAST_IO is available, digitalWrite() elsewhere.
+class ST7735_SwSPI {
+ public:
+  ST7735_SwSPI(int8_t sid, int8_t sclk) : _sid(sid), _sclk(sclk) {}
+  void init(void);
+  inline void begin(void) { }
+  inline void end(void) { }
+  inline void write(uint8_t c) {
+#if defined(USE_FAST_IO)
+    bit(c & 0x80); bit(c & 0x40); bit(c & 0x20); bit(c & 0x10);
+    bit(c & 0x08); bit(c & 0x04); bit(c & 0x02); bit(c & 0x01);
+#else
+    for(uint8_t b = 0x80; b; b >>= 1) {
+      digitalWrite(_sid, (c & b) ? HIGH : LOW);
+      digitalWrite(_sclk, HIGH);
+      digitalWrite(_sclk, LOW);
+    }
+#endif
+  }
+  inline void writeBuf(uint8_t *buf, uint16_t n) { while(n--) write(*buf++); }
+  void writeRepeat16(uint16_t c, uint32_t n);
+ private:
+  int8_t _sid, _sclk;
+#if defined(USE_FAST_IO)
+  volatile RwReg *dataport, *clkport;
+  #if defined(__AVR__) || defined(CORE_TEENSY)  // 8 bit!
+    uint8_t  datapinmask, clkpinmask;
+  #else    // 32 bit!
+    uint32_t  datapinmask, clkpinmask;
+  #endif
+  inline void clock(void) { *clkport |= clkpinmask; *clkport &= ~clkpinmask; }
+  inline void bit(boolean b) {
+    if(b) *dataport |= datapinmask; else *dataport &= ~datapinmask;
+    clock();
+  }
+  // one bit of a repeated word, the data line only moves when flip is set
+  inline void rbit(boolean flip) {
+    if(flip) *dataport ^= datapinmask;
+    clock();
+  }
+#endif
+};
+
+#if defined(ST7735_HOST)
+// Host builds: the bus is a byte log, so the whole driver runs as a plain
+// library on a PC.  tap, when set, sees every byte as it is sent.
+class ST7735_CaptureSPI {
+ public:
+  ST7735_CaptureSPI() : tap(NULL), writes(0), bufWrites(0), frames(0) {}
+  void init(void) { }
+  inline void begin(void) { frames++; }
+  inline void end(void) { }
+  inline void write(uint8_t c) {
+    writes++;
+    put(c);
+  }
+  inline void writeBuf(uint8_t *buf, uint16_t n) {
+    bufWrites++;
+    while(n--) put(*buf++);
+  }
+  void writeRepeat16(uint16_t c, uint32_t n) { ST7735_bufRepeat16(*this, c, n); }
+
+  std::vector<uint8_t> bytes;
+  void (*tap)(uint8_t c);
+  uint32_t writes, bufWrites, frames;
+ private:
+  inline void put(uint8_t c) {
+    bytes.push_back(c);
+    if(tap) tap(c);
+  }
+};
+#endif
+
+#endif
@@ -0,0 +1,40 @@
+/***************************************************
+  Scrolling log console using the ST7735 hardware scroll.
+
+  Each new line only costs one 8 pixel high strip on the bus, the rest of
+  the screen is moved by the controller.
+ ****************************************************/
+
+#include <Adafruit_GFX.h>    // Core graphics library
+#include <Adafruit_ST7735.h> // Hardware-specific library
+#include <ST7735_Console.h>
+#include <SPI.h>
+
+#define TFT_CS     10
+#define TFT_RST    9  // you can also connect this to the Arduino reset
+#define TFT_DC     8
+
+Adafruit_ST7735 tft = Adafruit_ST7735(TFT_CS,  TFT_DC, TFT_RST);
+
+// whole 128 pixel high panel: 16 lines of 8x8 tiles
+ST7735_Console console(tft, 0, 16);
+
+uint16_t count = 0;
+
+void setup(void) {
+  Serial.begin(9600);
+  tft.initR(INITR_144GREENTAB);
+  if(!console.begin()) {
+    Serial.println("console: out of memory");
+    while(1);
+  }
+}
+
+void loop() {
+  uint32_t time = micros();
+  console.print("LINE ");
+  console.println(count++);
+  time = micros() - time;
+  Serial.println(time, DEC);
+  delay(250);
+}
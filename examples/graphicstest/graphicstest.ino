@@ -42,7 +42,7 @@ Adafruit_ST7735 tft = Adafruit_ST7735(TFT_CS,  TFT_DC, TFT_RST);
 // Option 2: use any pins but a little slower!
 #define TFT_SCLK 13   // set these to be whatever pins you like!
 #define TFT_MOSI 11   // set these to be whatever pins you like!
-//Adafruit_ST7735 tft = Adafruit_ST7735(TFT_CS, TFT_DC, TFT_MOSI, TFT_SCLK, TFT_RST);
+//Adafruit_ST7735_SW tft = Adafruit_ST7735_SW(TFT_CS, TFT_DC, TFT_MOSI, TFT_SCLK, TFT_RST);
 
 
 float p = 3.1415926;
@@ -108,6 +108,15 @@ void setup(void) {
   delay(500);
 
   Serial.println("done");
+#if defined(ST7735_PROTOCOL_STATS)
+  // enable in Adafruit_ST7735.h to see what the window cache saves
+  Serial.print("bytes sent: ");   Serial.println(tft.stats().bytes);
+  Serial.print("bytes saved: ");  Serial.println(tft.stats().bytesSaved);
+  Serial.print("CS toggles: ");   Serial.print(tft.stats().csToggles);
+  Serial.print(" saved: ");       Serial.println(tft.stats().csSaved);
+  Serial.print("DC toggles: ");   Serial.print(tft.stats().dcToggles);
+  Serial.print(" saved: ");       Serial.println(tft.stats().dcSaved);
+#endif
   delay(1000);
 }
 
@@ -44,7 +44,7 @@
 #define TFT_DC   8
 #define TFT_RST  0  // you can also connect this to the Arduino reset
 
-Adafruit_ST7735 tft = Adafruit_ST7735(TFT_CS, TFT_DC, SPI_DO, SPI_SCK, TFT_RST);
+Adafruit_ST7735_SW tft = Adafruit_ST7735_SW(TFT_CS, TFT_DC, SPI_DO, SPI_SCK, TFT_RST);
 
 void setup(void) {
   Serial.begin(9600);
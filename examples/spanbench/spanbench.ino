@@ -0,0 +1,91 @@
+/***************************************************
+  Transparent sprite benchmark: per pixel drawPixel() against the
+  opaque-run span blitter, for masks of different densities.
+
+  The span tables are built once in RAM with buildSpans(); each timing is
+  the average of REPEAT draws of a 16x16 sprite, printed in microseconds.
+ ****************************************************/
+
+#include <Adafruit_GFX.h>    // Core graphics library
+#include <Adafruit_ST7735.h> // Hardware-specific library
+#include <SPI.h>
+
+#define TFT_CS     10
+#define TFT_RST    9  // you can also connect this to the Arduino reset
+#define TFT_DC     8
+
+#define SPR_W   16
+#define SPR_H   16
+#define REPEAT  50
+
+Adafruit_ST7735 tft = Adafruit_ST7735(TFT_CS,  TFT_DC, TFT_RST);
+
+// 1bpp masks, set bit = opaque
+const uint8_t maskSparse[] PROGMEM = { // ~25%, single pixels
+  0x88,0x88, 0x22,0x22, 0x88,0x88, 0x22,0x22, 0x88,0x88, 0x22,0x22, 0x88,0x88, 0x22,0x22,
+  0x88,0x88, 0x22,0x22, 0x88,0x88, 0x22,0x22, 0x88,0x88, 0x22,0x22, 0x88,0x88, 0x22,0x22 };
+const uint8_t maskHalf[] PROGMEM = {   // 50%, runs of 4
+  0xF0,0xF0, 0x0F,0x0F, 0xF0,0xF0, 0x0F,0x0F, 0xF0,0xF0, 0x0F,0x0F, 0xF0,0xF0, 0x0F,0x0F,
+  0xF0,0xF0, 0x0F,0x0F, 0xF0,0xF0, 0x0F,0x0F, 0xF0,0xF0, 0x0F,0x0F, 0xF0,0xF0, 0x0F,0x0F };
+const uint8_t maskBall[] PROGMEM = {   // ~80%, one run per row
+  0x07,0xE0, 0x1F,0xF8, 0x3F,0xFC, 0x7F,0xFE, 0x7F,0xFE, 0xFF,0xFF, 0xFF,0xFF, 0xFF,0xFF,
+  0xFF,0xFF, 0xFF,0xFF, 0xFF,0xFF, 0x7F,0xFE, 0x7F,0xFE, 0x3F,0xFC, 0x1F,0xF8, 0x07,0xE0 };
+
+const uint16_t pal[16] PROGMEM = {
+  ST7735_WHITE, ST7735_RED, ST7735_GREEN, ST7735_BLUE, ST7735_YELLOW, ST7735_CYAN, ST7735_MAGENTA, ST7735_BLACK,
+  ST7735_WHITE, ST7735_RED, ST7735_GREEN, ST7735_BLUE, ST7735_YELLOW, ST7735_CYAN, ST7735_MAGENTA, ST7735_BLACK };
+
+// shared colour indices, one byte per pixel
+const uint8_t colorIndex[SPR_W * SPR_H] PROGMEM = {
+  0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15, 1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,0,
+  2,3,4,5,6,7,8,9,10,11,12,13,14,15,0,1, 3,4,5,6,7,8,9,10,11,12,13,14,15,0,1,2,
+  4,5,6,7,8,9,10,11,12,13,14,15,0,1,2,3, 5,6,7,8,9,10,11,12,13,14,15,0,1,2,3,4,
+  6,7,8,9,10,11,12,13,14,15,0,1,2,3,4,5, 7,8,9,10,11,12,13,14,15,0,1,2,3,4,5,6,
+  8,9,10,11,12,13,14,15,0,1,2,3,4,5,6,7, 9,10,11,12,13,14,15,0,1,2,3,4,5,6,7,8,
+  10,11,12,13,14,15,0,1,2,3,4,5,6,7,8,9, 11,12,13,14,15,0,1,2,3,4,5,6,7,8,9,10,
+  12,13,14,15,0,1,2,3,4,5,6,7,8,9,10,11, 13,14,15,0,1,2,3,4,5,6,7,8,9,10,11,12,
+  14,15,0,1,2,3,4,5,6,7,8,9,10,11,12,13, 15,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14 };
+
+// worst case: 8 runs in each of 16 rows
+uint8_t spans[SPR_H * (1 + 2 * SPR_W / 2)];
+
+void drawPerPixel(int16_t x, int16_t y, const uint8_t mask[]) {
+  for(uint8_t j = 0; j < SPR_H; j++)
+    for(uint8_t i = 0; i < SPR_W; i++)
+      if(pgm_read_byte(&mask[j * 2 + i / 8]) & (0x80 >> (i & 7)))
+        tft.drawPixel(x + i, y + j, pgm_read_word(&pal[pgm_read_byte(&colorIndex[j * SPR_W + i])]));
+}
+
+void bench(const char *name, const uint8_t mask[]) {
+  uint16_t size = Adafruit_ST7735::buildSpans(mask, SPR_W, SPR_H, spans, sizeof(spans));
+
+  uint32_t t = micros();
+  for(uint8_t r = 0; r < REPEAT; r++) drawPerPixel(8, 8, mask);
+  uint32_t perPixel = (micros() - t) / REPEAT;
+
+  t = micros();
+  for(uint8_t r = 0; r < REPEAT; r++) tft.drawSpans(40, 8, SPR_W, SPR_H, spans, colorIndex, pal);
+  uint32_t perSpan = (micros() - t) / REPEAT;
+
+  Serial.print(name);
+  Serial.print(F(": table "));
+  Serial.print(size);
+  Serial.print(F(" bytes, per pixel "));
+  Serial.print(perPixel);
+  Serial.print(F(" us, spans "));
+  Serial.print(perSpan);
+  Serial.println(F(" us"));
+}
+
+void setup(void) {
+  Serial.begin(9600);
+  tft.initR(INITR_144GREENTAB);
+  tft.fillScreen(ST7735_BLACK);
+
+  bench("sparse", maskSparse);
+  bench("half",   maskHalf);
+  bench("ball",   maskBall);
+}
+
+void loop() {
+}
@@ -0,0 +1,126 @@
+/***************************************************
+  assetc - asset compiler for the ST7735 driver.
+
+  Cuts a BMP (8, 24 or 32 bit, uncompressed) or binary PPM (P6) sprite
+  sheet into tiles and stores every tile in whichever format the driver
+  can draw that costs least: 1bpp mono, packed 2/4bpp, byte per pixel,
+  or RLE V1/V2/V3.  Writes a header with the data, offset table, format
+  table, palette and an ST7735_Asset for drawAsset(), and reports flash
+  bytes and estimated draw time per tile on stderr.
+
+  Build:  g++ -std=c++11 -O2 -o assetc assetc.cpp
+          or make -C extras/host assetc, which builds extras/host/build/assetc
+  Usage:  assetc [-s speedWeight] [-c spiMHz] sheet.bmp tileW tileH name > name.h
+
+  The cost of a tile is flash bytes + speedWeight * estimated us to draw
+  it (default 1), so a larger weight trades flash for speed.  Palette
+  entries are sorted by use so 1bpp and 2bpp tiles are as common as they
+  can be; mono tiles draw index 0 on set bits and index 1 on clear ones.
+ ****************************************************/
+
+#include <string>
+#include <map>
+#include <algorithm>
+#include "assetc.h"
+
+static void dumpArray(const char *type, const std::string &name, const std::vector<unsigned> &v, int width)
+{
+  printf("const %s %s[] PROGMEM = {", type, name.c_str());
+  for(size_t i = 0; i < v.size(); i++) {
+    if(i % 16 == 0) printf("\n  ");
+    printf("0x%0*X%s", width, v[i], (i + 1 < v.size()) ? ", " : "");
+  }
+  printf("\n};\n\n");
+}
+
+int main(int argc, char **argv)
+{
+  double speedWeight = 1.0, spiMHz = 8.0;
+  int a = 1;
+  for(; a < argc && argv[a][0] == '-'; a += 2) {
+    if(a + 1 >= argc) die("missing value for ", argv[a]);
+    if(!strcmp(argv[a], "-s")) speedWeight = atof(argv[a + 1]);
+    else if(!strcmp(argv[a], "-c")) spiMHz = atof(argv[a + 1]);
+    else die("unknown option ", argv[a]);
+  }
+  if(argc - a != 4) die("usage: assetc [-s speedWeight] [-c spiMHz] sheet.bmp|.ppm tileW tileH name");
+  const char *path = argv[a];
+  int tw = atoi(argv[a + 1]), th = atoi(argv[a + 2]);
+  std::string name = argv[a + 3];
+  if(tw < 1 || th < 1 || tw > 255 || th > 255) die("tile size must be 1..255");
+
+  std::vector<uint8_t> file = readFile(path);
+  Image img;
+  if(file.size() > 2 && file[0] == 'B' && file[1] == 'M') img = readBMP(file);
+  else if(file.size() > 2 && file[0] == 'P' && file[1] == '6') img = readPPM(file);
+  else die("not a BMP or P6 PPM file: ", path);
+  if(img.w % tw || img.h % th) die("image size is not a multiple of the tile size");
+  int cols = img.w / tw, rows = img.h / th;
+  if(cols * rows > 255) die("more than 255 tiles");
+
+  // palette in RGB565, most used colour first
+  std::map<uint16_t, size_t> uses;
+  for(uint32_t c : img.rgb) uses[to565(c)]++;
+  if(uses.size() > 256) die("more than 256 colours after RGB565 conversion");
+  std::vector<std::pair<size_t, uint16_t> > order;
+  for(auto &u : uses) order.push_back(std::make_pair(u.second, u.first));
+  std::stable_sort(order.begin(), order.end(),
+    [](const std::pair<size_t, uint16_t> &x, const std::pair<size_t, uint16_t> &y) { return x.first > y.first; });
+  std::map<uint16_t, uint8_t> index;
+  std::vector<unsigned> pal;
+  for(auto &o : order) { index[o.second] = pal.size(); pal.push_back(o.second); }
+  while(pal.size() < 16) pal.push_back(0); // loadPalette() reads 16
+
+  std::vector<unsigned> data, offset, format;
+  size_t totalBytes = 0;
+  double totalUs = 0;
+  fprintf(stderr, "tile  format  bytes  est.us\n");
+  for(int t = 0; t < cols * rows; t++) {
+    int ox = (t % cols) * tw, oy = (t / cols) * th;
+    std::vector<uint8_t> px;
+    for(int y = 0; y < th; y++)
+      for(int x = 0; x < tw; x++) px.push_back(index[to565(img.rgb[(size_t)(oy + y) * img.w + ox + x])]);
+
+    std::vector<Encoded> cand;
+    if(fits(px, 2))  cand.push_back(packBits(px, tw, th, 1));
+    if(fits(px, 4))  cand.push_back(packBits(px, tw, th, 2));
+    if(fits(px, 16)) {
+      cand.push_back(packBits(px, tw, th, 4));
+      cand.push_back(byteEach(px));
+      cand.push_back(rleV1(px));
+      cand.push_back(rleV2(px));
+    }
+    cand.push_back(rleV3(px));
+
+    // bus time is the same for every format, the CPU time is not
+    double busUs = (WINDOW_BYTES + 2.0 * tw * th) * 8 / spiMHz;
+    const Encoded *best = NULL;
+    double bestCost = 0, bestUs = 0;
+    for(const Encoded &e : cand) {
+      double us = busUs + e.cycles / F_CPU_MHZ;
+      double cost = e.data.size() + speedWeight * us;
+      if(!best || cost < bestCost) { best = &e; bestCost = cost; bestUs = us; }
+    }
+    offset.push_back(data.size());
+    format.push_back(best->format);
+    data.insert(data.end(), best->data.begin(), best->data.end());
+    totalBytes += best->data.size();
+    totalUs += bestUs;
+    fprintf(stderr, "%4d  %-6s  %5zu  %6.0f\n", t, formatName(best->format), best->data.size(), bestUs);
+  }
+  if(data.size() > 0xFFFF) die("more than 64K of tile data");
+  size_t tables = data.size() + offset.size() * 2 + format.size() + pal.size() * 2;
+  fprintf(stderr, "%d tiles: %zu data bytes, %zu with tables, %.0f us to draw them all\n",
+    cols * rows, totalBytes, tables, totalUs);
+
+  printf("// Generated by assetc from %s, %dx%d tiles.\n", path, tw, th);
+  printf("// %d tiles, %zu bytes of flash.\n\n", cols * rows, tables);
+  printf("#include <Adafruit_ST7735.h>\n\n");
+  dumpArray("uint16_t", name + "_pal", pal, 4);
+  dumpArray("uint8_t", name + "_data", data, 2);
+  dumpArray("uint16_t", name + "_offset", offset, 4);
+  dumpArray("uint8_t", name + "_format", format, 2);
+  printf("const ST7735_Asset %s = { %d, %d, %d, %s_data, %s_offset, %s_format, %s_pal };\n",
+    name.c_str(), tw, th, cols * rows, name.c_str(), name.c_str(), name.c_str(), name.c_str());
+  return 0;
+}
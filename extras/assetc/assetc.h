@@ -0,0 +1,266 @@
+// Image readers and tile encoders shared by assetc and the host checks in
+// extras/host, so the bytes those exercise are the ones assetc writes.
+
+#ifndef _ASSETC_H_
+#define _ASSETC_H_
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <cstdint>
+#include <vector>
+
+// mirrors of the driver's constants (Adafruit_ST7735.h)
+#ifndef ST7735_RLE_V1
+#define ST7735_RLE_V1    1
+#define ST7735_RLE_V2    2
+#define ST7735_RLE_V3    3
+#define ST7735_ASSET_RLE 0x10
+#define ST7735_PACKED    0x20
+#endif
+
+// Decode cost model, CPU cycles on a 16MHz AVR: per pixel for the raw
+// formats, per packet plus per pixel for RLE.  Rough figures from the
+// inner loops; only their ratios matter when picking a format.
+static const double F_CPU_MHZ     = 16.0;
+static const double CYC_MONO      = 6;
+static const double CYC_PACK2     = 7;
+static const double CYC_PACK4     = 8;
+static const double CYC_BYTE      = 12;
+static const double CYC_PACKET    = 40;
+static const double CYC_RUN_PX    = 2;
+static const double CYC_LITERAL_PX = 12;
+static const int    WINDOW_BYTES  = 11; // CASET + RASET + RAMWR
+
+struct Image {
+  int w, h;
+  std::vector<uint32_t> rgb; // 0xRRGGBB
+};
+
+struct Encoded {
+  uint8_t format;
+  std::vector<uint8_t> data;
+  double cycles;
+};
+
+static inline void die(const char *msg, const char *arg = "")
+{
+  fprintf(stderr, "assetc: %s%s\n", msg, arg);
+  exit(1);
+}
+
+static inline std::vector<uint8_t> readFile(const char *path)
+{
+  FILE *f = fopen(path, "rb");
+  if(!f) die("cannot open ", path);
+  std::vector<uint8_t> buf;
+  uint8_t chunk[4096];
+  size_t n;
+  while((n = fread(chunk, 1, sizeof(chunk), f)) > 0) buf.insert(buf.end(), chunk, chunk + n);
+  fclose(f);
+  return buf;
+}
+
+static inline uint32_t le(const std::vector<uint8_t> &b, size_t at, int n)
+{
+  if(at + n > b.size()) die("truncated file");
+  uint32_t v = 0;
+  for(int i = n - 1; i >= 0; i--) v = (v << 8) | b[at + i];
+  return v;
+}
+
+static inline Image readBMP(const std::vector<uint8_t> &b)
+{
+  Image img;
+  uint32_t dataAt = le(b, 10, 4);
+  int32_t  w      = (int32_t)le(b, 18, 4);
+  int32_t  h      = (int32_t)le(b, 22, 4);
+  int      bpp    = le(b, 28, 2);
+  uint32_t comp   = le(b, 30, 4);
+  uint32_t hdr    = le(b, 14, 4);
+  if(comp != 0 && !(comp == 3 && bpp == 32)) die("compressed BMPs are not supported");
+  if(bpp != 8 && bpp != 24 && bpp != 32) die("BMP must be 8, 24 or 32 bit");
+  bool topDown = h < 0;
+  if(topDown) h = -h;
+  img.w = w;
+  img.h = h;
+  img.rgb.resize((size_t)w * h);
+
+  std::vector<uint32_t> pal;
+  if(bpp == 8) {
+    uint32_t n = le(b, 46, 4);
+    if(!n) n = 256;
+    for(uint32_t i = 0; i < n; i++) pal.push_back(le(b, 14 + hdr + i * 4, 4) & 0xFFFFFF);
+  }
+  size_t stride = ((size_t)w * bpp / 8 + 3) & ~(size_t)3;
+  for(int y = 0; y < h; y++) {
+    size_t row = dataAt + (size_t)(topDown ? y : h - 1 - y) * stride;
+    for(int x = 0; x < w; x++) {
+      uint32_t c;
+      if(bpp == 8) {
+        uint32_t i = le(b, row + x, 1);
+        if(i >= pal.size()) die("BMP palette index out of range");
+        c = pal[i];
+      } else {
+        c = le(b, row + (size_t)x * (bpp / 8), 3);
+      }
+      img.rgb[(size_t)y * w + x] = c;
+    }
+  }
+  return img;
+}
+
+static inline Image readPPM(const std::vector<uint8_t> &b)
+{
+  // P6 <w> <h> <maxval> then binary RGB, with # comments in the header
+  size_t at = 2;
+  int v[3];
+  for(int k = 0; k < 3; k++) {
+    while(at < b.size()) {
+      if(b[at] == '#') { while(at < b.size() && b[at] != '\n') at++; }
+      else if(isspace(b[at])) at++;
+      else break;
+    }
+    v[k] = 0;
+    while(at < b.size() && isdigit(b[at])) v[k] = v[k] * 10 + (b[at++] - '0');
+  }
+  at++;
+  if(v[2] != 255) die("PPM maxval must be 255");
+  Image img;
+  img.w = v[0];
+  img.h = v[1];
+  if(at + (size_t)img.w * img.h * 3 > b.size()) die("truncated PPM");
+  img.rgb.resize((size_t)img.w * img.h);
+  for(size_t i = 0; i < img.rgb.size(); i++, at += 3)
+    img.rgb[i] = ((uint32_t)b[at] << 16) | (b[at + 1] << 8) | b[at + 2];
+  return img;
+}
+
+static inline uint16_t to565(uint32_t c)
+{
+  return ((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F);
+}
+
+// ---- encoders, each the exact inverse of the matching driver path ----
+
+static inline bool fits(const std::vector<uint8_t> &px, int colours)
+{
+  for(uint8_t c : px) if(c >= colours) return false;
+  return true;
+}
+
+static inline Encoded packBits(const std::vector<uint8_t> &px, int w, int h, int bits)
+{
+  // drawCBMPsection(): first pixel in the high bits, rows padded to a byte
+  Encoded e;
+  e.format = (bits == 1) ? 1 : ST7735_PACKED | bits;
+  int rowBytes = (w * bits + 7) / 8;
+  e.data.assign((size_t)rowBytes * h, 0);
+  for(int y = 0; y < h; y++)
+    for(int x = 0; x < w; x++) {
+      uint8_t c = px[(size_t)y * w + x];
+      if(bits == 1) c = (c == 0); // set bit draws pal[0]
+      int bit = x * bits;
+      e.data[(size_t)y * rowBytes + bit / 8] |= c << (8 - bits - bit % 8);
+    }
+  double cyc = (bits == 1) ? CYC_MONO : (bits == 2) ? CYC_PACK2 : CYC_PACK4;
+  e.cycles = cyc * w * h;
+  return e;
+}
+
+static inline Encoded byteEach(const std::vector<uint8_t> &px)
+{
+  Encoded e;
+  e.format = 4; // one 16 colour index per byte
+  e.data = px;
+  e.cycles = CYC_BYTE * px.size();
+  return e;
+}
+
+static inline size_t runAt(const std::vector<uint8_t> &px, size_t i, size_t cap)
+{
+  size_t n = 1;
+  while(i + n < px.size() && px[i + n] == px[i] && n < cap) n++;
+  return n;
+}
+
+static inline Encoded rleV1(const std::vector<uint8_t> &px)
+{
+  Encoded e;
+  e.format = ST7735_ASSET_RLE | ST7735_RLE_V1;
+  e.cycles = 0;
+  for(size_t i = 0; i < px.size();) {
+    size_t n = runAt(px, i, 16);
+    e.data.push_back((px[i] << 4) | (n - 1));
+    e.cycles += CYC_PACKET + CYC_RUN_PX * n;
+    i += n;
+  }
+  return e;
+}
+
+static inline Encoded rleV2(const std::vector<uint8_t> &px)
+{
+  // runs of 3 or more, everything else in packed literal packets
+  Encoded e;
+  e.format = ST7735_ASSET_RLE | ST7735_RLE_V2;
+  e.cycles = 0;
+  for(size_t i = 0; i < px.size();) {
+    size_t n = runAt(px, i, 263);
+    if(n >= 3) {
+      if(n <= 7) e.data.push_back(((n - 1) << 4) | px[i]);
+      else { e.data.push_back(0x70 | px[i]); e.data.push_back(n - 8); }
+      e.cycles += CYC_PACKET + CYC_RUN_PX * n;
+      i += n;
+      continue;
+    }
+    size_t j = i;
+    while(j < px.size() && j - i < 128 && runAt(px, j, 3) < 3) j++;
+    e.data.push_back(0x80 | (j - i - 1));
+    for(size_t k = i; k < j; k += 2)
+      e.data.push_back((px[k] << 4) | ((k + 1 < j) ? px[k + 1] : 0));
+    e.cycles += CYC_PACKET + CYC_LITERAL_PX * (j - i);
+    i = j;
+  }
+  return e;
+}
+
+static inline Encoded rleV3(const std::vector<uint8_t> &px)
+{
+  // PackBits style: runs of 2 or more, literals of single pixels
+  Encoded e;
+  e.format = ST7735_ASSET_RLE | ST7735_RLE_V3;
+  e.cycles = 0;
+  for(size_t i = 0; i < px.size();) {
+    size_t n = runAt(px, i, 128);
+    if(n >= 2) {
+      e.data.push_back(0x80 | (n - 1));
+      e.data.push_back(px[i]);
+      e.cycles += CYC_PACKET + CYC_RUN_PX * n;
+      i += n;
+      continue;
+    }
+    size_t j = i;
+    while(j < px.size() && j - i < 128 && runAt(px, j, 2) < 2) j++;
+    e.data.push_back(j - i - 1);
+    e.data.insert(e.data.end(), px.begin() + i, px.begin() + j);
+    e.cycles += CYC_PACKET + CYC_LITERAL_PX * (j - i);
+    i = j;
+  }
+  return e;
+}
+
+static inline const char *formatName(uint8_t f)
+{
+  switch(f) {
+    case 1:  return "mono";
+    case ST7735_PACKED | 2: return "2bpp";
+    case ST7735_PACKED | 4: return "4bpp";
+    case 4:  return "byte";
+    case ST7735_ASSET_RLE | ST7735_RLE_V1: return "rle1";
+    case ST7735_ASSET_RLE | ST7735_RLE_V2: return "rle2";
+    default: return "rle3";
+  }
+}
+
+#endif
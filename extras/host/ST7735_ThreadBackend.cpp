@@ -0,0 +1,75 @@
+// Worker thread line backend, see ST7735_ThreadBackend.h.
+
+#include "ST7735_ThreadBackend.h"
+#include <chrono>
+
+ST7735_ThreadBackend::ST7735_ThreadBackend(double usPerByte)
+  : _usPerByte(usPerByte), _busy(false), _waited(false), _quit(false),
+    _buf(NULL), _n(0) {
+  clearStats();
+  _worker = std::thread(&ST7735_ThreadBackend::run, this);
+}
+
+ST7735_ThreadBackend::~ST7735_ThreadBackend(void) {
+  {
+    std::lock_guard<std::mutex> l(_lock);
+    _quit = true;
+  }
+  _wake.notify_one();
+  _worker.join();
+}
+
+void ST7735_ThreadBackend::clearStats(void) {
+  lines = stalls = 0;
+  busUs = waitUs = 0;
+  _waited = false;
+}
+
+// The driver only calls this once busy() is false, so there is never
+// more than one line queued.
+void ST7735_ThreadBackend::transfer(const uint8_t *buf, uint16_t n) {
+  {
+    std::lock_guard<std::mutex> l(_lock);
+    _buf = buf;
+    _n = n;
+    lines++;
+    if(_waited) stalls++;
+    _waited = false;
+    _busy = true;
+  }
+  _wake.notify_one();
+  std::this_thread::yield(); // start the line now, as DMA would
+}
+
+// Time from the first busy() that says yes until the line is done is
+// time the driver spent waiting for the bus.
+bool ST7735_ThreadBackend::busy(void) {
+  if(!_busy) {
+    if(_waitFrom != hostClock::time_point()) {
+      waitUs += std::chrono::duration<double, std::micro>(hostClock::now() - _waitFrom).count();
+      _waitFrom = hostClock::time_point();
+    }
+    return false;
+  }
+  if(_waitFrom == hostClock::time_point()) _waitFrom = hostClock::now();
+  _waited = true;
+  std::this_thread::yield();
+  return true;
+}
+
+void ST7735_ThreadBackend::run(void) {
+  std::unique_lock<std::mutex> l(_lock);
+  for(;;) {
+    _wake.wait(l, [this] { return _quit || _buf; });
+    if(_quit) return;
+    hostClock::time_point t0 = hostClock::now();
+    SPI.transfer((void *)_buf, _n);
+    // the bus, not the CPU, is busy for the rest of the line
+    l.unlock();
+    std::this_thread::sleep_until(t0 + std::chrono::nanoseconds((long long)(_n * _usPerByte * 1000)));
+    l.lock();
+    busUs += std::chrono::duration<double, std::micro>(hostClock::now() - t0).count();
+    _buf = NULL;
+    _busy = false;
+  }
+}
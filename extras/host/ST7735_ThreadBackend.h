@@ -0,0 +1,53 @@
+// Line backend for the host build that sends on a worker thread, the way
+// a DMA channel would on an MCU, so the async line engine's overlap of
+// decoding and sending can be measured without hardware.
+//
+// transfer() hands the line to the worker and returns; the worker pushes
+// it through the SPI stub into the model, then sleeps out the time the
+// bytes would take on a real bus (usPerByte, 1 at 8 MHz) before busy()
+// clears.
+
+#ifndef _ST7735_THREADBACKEND_H_
+#define _ST7735_THREADBACKEND_H_
+
+#include "Adafruit_ST7735.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+typedef std::chrono::steady_clock hostClock;
+
+class ST7735_ThreadBackend : public ST7735_LineBackend {
+
+ public:
+
+  ST7735_ThreadBackend(double usPerByte = 1.0);
+  ~ST7735_ThreadBackend(void);
+
+  void     transfer(const uint8_t *buf, uint16_t n);
+  bool     busy(void);
+  void     clearStats(void);
+
+  // since clearStats()
+  uint32_t lines;   // transfers
+  uint32_t stalls;  // lines the driver had ready before the bus was free
+  double   busUs;   // time the worker spent sending
+  double   waitUs;  // time the driver spent in busy() waiting for it
+
+ private:
+  void     run(void);
+
+  double   _usPerByte;
+  std::thread _worker;
+  std::mutex  _lock;
+  std::condition_variable _wake;
+  std::atomic<bool> _busy;
+  bool     _waited, _quit;
+  hostClock::time_point _waitFrom;
+  const uint8_t *_buf;
+  uint16_t _n;
+};
+
+#endif
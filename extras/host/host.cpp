@@ -0,0 +1,445 @@
+// Stub core, SPI and GFX for the host build, and the controller model,
+// see host.h.
+
+#include "host.h"
+#include <SPI.h>
+
+ST7735_Model model;
+SPIClass SPI;
+volatile ST7735_HostPort hostPorts[ST7735_HOST_PINS];
+int hostFailures = 0;
+
+/******** core **********/
+
+void ST7735_HostPort::set(uint8_t l) volatile
+{
+  level = l;
+  model.pin(this - hostPorts, l);
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {}
+
+void digitalWrite(uint8_t pin, uint8_t level)
+{
+  hostPorts[pin].set(level ? 1 : 0);
+}
+
+void delay(unsigned long ms) {}
+unsigned long millis(void) { return 0; }
+unsigned long micros(void) { return 0; }
+
+/******** SPI **********/
+
+void SPIClass::begin(void) {}
+void SPIClass::setClockDivider(uint8_t div) {}
+void SPIClass::setDataMode(uint8_t mode) {}
+
+void SPIClass::beginTransaction(SPISettings s)
+{
+  if(model._inTx) model.errors++;
+  model._inTx = 1;
+  model.transactions++;
+}
+
+void SPIClass::endTransaction(void)
+{
+  if(!model._inTx) model.errors++;
+  model._inTx = 0;
+}
+
+uint8_t SPIClass::transfer(uint8_t c)
+{
+  if(!model._inTx) model.errors++;
+  model.spiByteCalls++;
+  model.byte(c);
+  return 0xFF;
+}
+
+void SPIClass::transfer(void *buf, size_t n)
+{
+  if(!model._inTx) model.errors++;
+  model.spiBufCalls++;
+  uint8_t *p = (uint8_t *)buf;
+  for(size_t i = 0; i < n; i++) {
+    model.byte(p[i]);
+    p[i] = 0xFF; // what comes back on MISO
+  }
+}
+
+/******** controller model **********/
+
+void ST7735_Model::reset(void)
+{
+  memset(gram, 0, sizeof(gram));
+  madctl = 0;
+  colmod = COLOR_565;
+  xstart = 0;
+  ystart = 0;
+  tfa = 0;
+  vsa = ST7735_GRAM_HEIGHT;
+  vsp = 0;
+  psr = 0;
+  per = ST7735_GRAM_HEIGHT - 1;
+  partial = idle = false;
+  _cs = _dc = 1;
+  _sclk = _sid = 0;
+  _inTx = 0;
+  _ramwr = false;
+  _xs = 0; _xe = ST7735_GRAM_WIDTH - 1;
+  _ys = 0; _ye = ST7735_GRAM_HEIGHT - 1;
+  _nbits = 0;
+  clearLog();
+}
+
+void ST7735_Model::clearLog(void)
+{
+  log.clear();
+  ramBytes.clear();
+  spiByteCalls = spiBufCalls = transactions = csFrames = commands = 0;
+  csWrites = dcWrites = 0;
+  sclkPulses = sidChanges = sidWrites = pixels = errors = 0;
+}
+
+// GRAM column/row that raw address (a, b) lands on, as the driver's
+// gramPos(): with MV set CASET addresses rows, MY/MX mirror.
+static void gramPos(uint8_t m, int16_t a, int16_t b, int16_t &pc, int16_t &pr)
+{
+  if(m & 0x20) {
+    pr = (m & 0x80) ? (ST7735_GRAM_HEIGHT - 1) - a : a;
+    pc = (m & 0x40) ? (ST7735_GRAM_WIDTH - 1) - b : b;
+  } else {
+    pc = (m & 0x40) ? (ST7735_GRAM_WIDTH - 1) - a : a;
+    pr = (m & 0x80) ? (ST7735_GRAM_HEIGHT - 1) - b : b;
+  }
+}
+
+uint16_t ST7735_Model::at(int16_t x, int16_t y)
+{
+  int16_t pc, pr;
+  gramPos(madctl, x + xstart, y + ystart, pc, pr);
+  if((pc < 0) || (pc >= ST7735_GRAM_WIDTH) || (pr < 0) || (pr >= ST7735_GRAM_HEIGHT)) return 0xDEAD;
+  return gram[pr][pc];
+}
+
+std::vector<uint16_t> ST7735_Model::screen(int16_t w, int16_t h)
+{
+  std::vector<uint16_t> s;
+  for(int16_t y = 0; y < h; y++)
+    for(int16_t x = 0; x < w; x++) s.push_back(at(x, y));
+  return s;
+}
+
+// Panel line pr shows GRAM row pr, except inside the scroll area, where
+// its first line shows row vsp and the rest follow on, wrapping round.
+// In partial mode lines outside PTLAR are black, in idle mode every
+// channel is cut to its top bit.
+uint16_t ST7735_Model::shown(int16_t x, int16_t y)
+{
+  int16_t pc, pr;
+  gramPos(madctl, x + xstart, y + ystart, pc, pr);
+  if((pc < 0) || (pc >= ST7735_GRAM_WIDTH) || (pr < 0) || (pr >= ST7735_GRAM_HEIGHT)) return 0xDEAD;
+  if(partial && ((pr < psr) || (pr > per))) return 0x0000;
+  if(vsa && (pr >= tfa) && (pr < tfa + vsa)) pr = tfa + (pr - tfa + vsp - tfa + vsa) % vsa;
+  uint16_t c = gram[pr][pc];
+  if(idle) c = ((c & 0x8000) ? 0xF800 : 0) | ((c & 0x0400) ? 0x07E0 : 0) | ((c & 0x0010) ? 0x001F : 0);
+  return c;
+}
+
+std::vector<uint16_t> ST7735_Model::shownScreen(int16_t w, int16_t h)
+{
+  std::vector<uint16_t> s;
+  for(int16_t y = 0; y < h; y++)
+    for(int16_t x = 0; x < w; x++) s.push_back(shown(x, y));
+  return s;
+}
+
+void ST7735_Model::pixel(uint16_t c)
+{
+  int16_t pc, pr;
+  gramPos(madctl, _col, _row, pc, pr);
+  if((pc >= 0) && (pc < ST7735_GRAM_WIDTH) && (pr >= 0) && (pr < ST7735_GRAM_HEIGHT)) gram[pr][pc] = c;
+  pixels++;
+  if(++_col > _xe) {
+    _col = _xs;
+    if(++_row > _ye) _row = _ys;
+  }
+}
+
+void ST7735_Model::byte(uint8_t v)
+{
+  if(_cs) {
+    errors++;
+    return;
+  }
+  log.push_back((_dc ? 0x100 : 0) | v);
+
+  if(!_dc) {
+    if(v == ST7735_PTLON)  partial = true;
+    if(v == ST7735_NORON)  partial = false;
+    if(v == ST7735_IDMON)  idle = true;
+    if(v == ST7735_IDMOFF) idle = false;
+    // a command drops any half-sent RGB444 pixel
+    _cmd = v;
+    _nargs = 0;
+    _ramwr = (v == ST7735_RAMWR);
+    _acc = 0;
+    _accBits = 0;
+    if(_ramwr) {
+      _col = _xs;
+      _row = _ys;
+    }
+    commands++;
+    return;
+  }
+
+  if(_ramwr) {
+    ramBytes.push_back(v);
+    uint8_t bpp = (colmod == COLOR_444) ? 12 : 16;
+    _acc = (_acc << 8) | v;
+    _accBits += 8;
+    while(_accBits >= bpp) {
+      _accBits -= bpp;
+      pixel((_acc >> _accBits) & ((1 << bpp) - 1));
+    }
+    return;
+  }
+
+  if(_nargs < sizeof(_args)) _args[_nargs] = v;
+  _nargs++;
+  if((_cmd == ST7735_CASET) && (_nargs == 4)) {
+    _xs = (_args[0] << 8) | _args[1];
+    _xe = (_args[2] << 8) | _args[3];
+  }
+  if((_cmd == ST7735_RASET) && (_nargs == 4)) {
+    _ys = (_args[0] << 8) | _args[1];
+    _ye = (_args[2] << 8) | _args[3];
+  }
+  if((_cmd == ST7735_VSCRDEF) && (_nargs == 4)) {
+    tfa = (_args[0] << 8) | _args[1];
+    vsa = (_args[2] << 8) | _args[3];
+  }
+  if((_cmd == ST7735_VSCRDEF) && (_nargs == 6) && (tfa + vsa + ((_args[4] << 8) | _args[5]) != ST7735_GRAM_HEIGHT))
+    errors++; // the three areas must cover the panel
+  if((_cmd == ST7735_VSCRSADD) && (_nargs == 2)) {
+    vsp = (_args[0] << 8) | _args[1];
+    if((vsp < tfa) || (vsp >= tfa + vsa)) errors++;
+  }
+  if((_cmd == ST7735_PTLAR) && (_nargs == 4)) {
+    psr = (_args[0] << 8) | _args[1];
+    per = (_args[2] << 8) | _args[3];
+  }
+  if((_cmd == ST7735_MADCTL) && (_nargs == 1)) madctl = v;
+  if((_cmd == ST7735_COLMOD) && (_nargs == 1)) colmod = v & 7;
+}
+
+// Pin changes.  Software SPI is received here: mode 0, sampled on the
+// rising clock edge, MSB first.
+void ST7735_Model::pin(uint8_t p, uint8_t level)
+{
+  switch(p) {
+    case TFT_CS:
+      csWrites++;
+      if(!level && _cs) csFrames++;
+      if(level && _nbits) { // CS went up part way into a byte
+        errors++;
+        _nbits = 0;
+      }
+      _cs = level;
+      break;
+    case TFT_DC:
+      dcWrites++;
+      _dc = level;
+      break;
+    case TFT_SID:
+      sidWrites++;
+      if(level != _sid) sidChanges++;
+      _sid = level;
+      break;
+    case TFT_SCLK:
+      if(level && !_sclk && !_cs) {
+        sclkPulses++;
+        _shift = (_shift << 1) | _sid;
+        if(++_nbits == 8) {
+          _nbits = 0;
+          byte(_shift);
+        }
+      }
+      _sclk = level;
+      break;
+  }
+}
+
+/******** checks **********/
+
+void hostFail(const char *what, const char *file, int line)
+{
+  hostFailures++;
+  if(hostFailures <= 20) printf("%s:%d: CHECK(%s) failed\n", file, line, what);
+}
+
+int hostDone(const char *name)
+{
+  if(hostFailures) printf("%s: %d failed\n", name, hostFailures);
+  else printf("%s: ok\n", name);
+  return hostFailures ? 1 : 0;
+}
+
+/******** Adafruit_GFX **********/
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h)
+{
+  _width    = WIDTH;
+  _height   = HEIGHT;
+  rotation  = 0;
+  cursor_x  = cursor_y = 0;
+  textsize  = 1;
+  textcolor = textbgcolor = 0xFFFF;
+  wrap      = true;
+  gfxFont   = NULL;
+}
+
+void Adafruit_GFX::startWrite(void) {}
+void Adafruit_GFX::endWrite(void) {}
+
+void Adafruit_GFX::writePixel(int16_t x, int16_t y, uint16_t color)
+{
+  drawPixel(x, y, color);
+}
+
+void Adafruit_GFX::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+  drawFastVLine(x, y, h, color);
+}
+
+void Adafruit_GFX::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+  drawFastHLine(x, y, w, color);
+}
+
+void Adafruit_GFX::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  fillRect(x, y, w, h, color);
+}
+
+// Bresenham, as in Adafruit_GFX
+void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+  boolean steep = abs(y1 - y0) > abs(x1 - x0);
+  int16_t t;
+  if(steep) {
+    t = x0; x0 = y0; y0 = t;
+    t = x1; x1 = y1; y1 = t;
+  }
+  if(x0 > x1) {
+    t = x0; x0 = x1; x1 = t;
+    t = y0; y0 = y1; y1 = t;
+  }
+  int16_t dx = x1 - x0, dy = abs(y1 - y0);
+  int16_t err = dx / 2, ystep = (y0 < y1) ? 1 : -1;
+  for(; x0 <= x1; x0++) {
+    if(steep) writePixel(y0, x0, color);
+    else      writePixel(x0, y0, color);
+    err -= dy;
+    if(err < 0) {
+      y0 += ystep;
+      err += dx;
+    }
+  }
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+  startWrite();
+  writeLine(x, y, x, y + h - 1, color);
+  endWrite();
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+  startWrite();
+  writeLine(x, y, x + w - 1, y, color);
+  endWrite();
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  startWrite();
+  for(int16_t i = x; i < x + w; i++) writeFastVLine(i, y, h, color);
+  endWrite();
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color)
+{
+  fillRect(0, 0, _width, _height, color);
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+  if(x0 == x1) {
+    if(y0 > y1) { int16_t t = y0; y0 = y1; y1 = t; }
+    drawFastVLine(x0, y0, y1 - y0 + 1, color);
+  } else if(y0 == y1) {
+    if(x0 > x1) { int16_t t = x0; x0 = x1; x1 = t; }
+    drawFastHLine(x0, y0, x1 - x0 + 1, color);
+  } else {
+    startWrite();
+    writeLine(x0, y0, x1, y1, color);
+    endWrite();
+  }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  startWrite();
+  writeFastHLine(x, y, w, color);
+  writeFastHLine(x, y + h - 1, w, color);
+  writeFastVLine(x, y, h, color);
+  writeFastVLine(x + w - 1, y, h, color);
+  endWrite();
+}
+
+void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+  int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r;
+  startWrite();
+  writePixel(x0, y0 + r, color);
+  writePixel(x0, y0 - r, color);
+  writePixel(x0 + r, y0, color);
+  writePixel(x0 - r, y0, color);
+  while(x < y) {
+    if(f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    writePixel(x0 + x, y0 + y, color);
+    writePixel(x0 - x, y0 + y, color);
+    writePixel(x0 + x, y0 - y, color);
+    writePixel(x0 - x, y0 - y, color);
+    writePixel(x0 + y, y0 + x, color);
+    writePixel(x0 - y, y0 + x, color);
+    writePixel(x0 + y, y0 - x, color);
+    writePixel(x0 - y, y0 - x, color);
+  }
+  endWrite();
+}
+
+void Adafruit_GFX::setRotation(uint8_t r)
+{
+  rotation = r & 3;
+  _width  = (rotation & 1) ? HEIGHT : WIDTH;
+  _height = (rotation & 1) ? WIDTH : HEIGHT;
+}
+
+void Adafruit_GFX::invertDisplay(boolean i) {}
+
+void Adafruit_GFX::setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+void Adafruit_GFX::setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+void Adafruit_GFX::setTextColor(uint16_t c, uint16_t bg) { textcolor = c; textbgcolor = bg; }
+void Adafruit_GFX::setTextWrap(boolean w) { wrap = w; }
+void Adafruit_GFX::setFont(const GFXfont *f) { gfxFont = (GFXfont *)f; }
+
+size_t Adafruit_GFX::write(uint8_t c) { return 1; }
@@ -0,0 +1,72 @@
+// Host harness for the ST7735 driver.
+//
+// The stub core in stub/ turns every SPI byte and pin change into calls on
+// a model of the controller, which decodes commands, the address window,
+// MADCTL and COLMOD into GRAM the way the chip does and keeps a log of the
+// traffic.  Tests draw through the real driver and check what landed.
+// See the Makefile for the build.
+
+#ifndef _ST7735_HOST_H_
+#define _ST7735_HOST_H_
+
+#include <stdio.h>
+#include <vector>
+#include <algorithm>
+#include "Adafruit_ST7735.h"
+
+// wiring used by every test
+#define TFT_CS   10
+#define TFT_DC   8
+#define TFT_RST  9
+#define TFT_SID  11
+#define TFT_SCLK 13
+
+struct ST7735_Model {
+  uint16_t gram[ST7735_GRAM_HEIGHT][ST7735_GRAM_WIDTH];
+  uint8_t  madctl, colmod;
+  int16_t  xstart, ystart; // panel offset the driver adds, for at()
+  uint16_t tfa, vsa, vsp;  // VSCRDEF top and scroll area, VSCRSADD
+  uint16_t psr, per;       // PTLAR rows
+  boolean  partial, idle;  // PTLON (until NORON), IDMON
+
+  // traffic since clearLog()
+  std::vector<uint16_t> log;      // every byte, 0x100 set when DC was high
+  std::vector<uint8_t>  ramBytes; // pixel data after RAMWR
+  uint32_t spiByteCalls, spiBufCalls, transactions, csFrames, commands;
+  uint32_t csWrites, dcWrites; // every write to the pin, changed or not
+  uint32_t sclkPulses, sidChanges, sidWrites, pixels;
+  uint32_t errors; // bytes with CS high, unbalanced transactions, stray bits
+
+  ST7735_Model() { reset(); }
+  void     reset(void);    // GRAM and controller state
+  void     clearLog(void);
+  uint16_t at(int16_t x, int16_t y); // GRAM under logical x, y
+  std::vector<uint16_t> screen(int16_t w, int16_t h);
+  uint16_t shown(int16_t x, int16_t y); // what the panel shows there: scrolled, partial, idle
+  std::vector<uint16_t> shownScreen(int16_t w, int16_t h);
+
+  // bus side, called from the stubs
+  void     byte(uint8_t v);
+  void     pin(uint8_t p, uint8_t level);
+
+ private:
+  uint8_t  _cs, _dc, _sclk, _sid, _inTx;
+  uint8_t  _cmd, _nargs, _args[16];
+  boolean  _ramwr;
+  int16_t  _xs, _xe, _ys, _ye, _col, _row;
+  uint32_t _acc;
+  uint8_t  _accBits;
+  uint8_t  _shift, _nbits; // software SPI receiver
+  void     pixel(uint16_t c);
+  friend class SPIClass;
+};
+
+extern ST7735_Model model;
+
+// checks
+extern int hostFailures;
+void hostFail(const char *what, const char *file, int line);
+int  hostDone(const char *name); // summary line, exit status for main()
+#define CHECK(c) ((c) ? (void)0 : hostFail(#c, __FILE__, __LINE__))
+
+#endif
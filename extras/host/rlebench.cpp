@@ -0,0 +1,171 @@
+// RLE formats side by side.  Every 32x32 tile of a few sheets is encoded
+// as V1, V2 and V3 with assetc's encoders and drawn through
+// drawCBMPsectionRLE(); all three must put the sheet's pixels, and the
+// same pixel stream, on the panel.  Prints the data bytes of each format
+// and the time rleDecode() takes to unpack the whole sheet on this host,
+// which only says how the formats compare, not what an AVR takes.
+//
+//   make bench
+
+#include <chrono>
+#include "host.h"
+#include "assetc.h"
+
+static Adafruit_ST7735 tft(TFT_CS, TFT_DC, TFT_RST);
+
+#define SHEET_W 128
+#define SHEET_H 64
+#define TILE    32
+#define TILES   ((SHEET_W / TILE) * (SHEET_H / TILE))
+#define ROUNDS  200
+
+struct Sheet {
+  const char *name;
+  std::vector<uint16_t> rgb; // RGB565, SHEET_W x SHEET_H
+};
+
+static const uint16_t ink[8] = {
+  ST7735_WHITE, ST7735_YELLOW, ST7735_CYAN, ST7735_GREEN,
+  ST7735_RED, ST7735_MAGENTA, 0xFD20, 0x7BEF
+};
+
+// tileFont, a row of glyphs per colour, drawn by drawFont() and read back
+static Sheet fontSheet(void)
+{
+  tft.fillScreen(ST7735_BLACK);
+  for(uint8_t r = 0; r < SHEET_H / FONT_TILESZ; r++) {
+    char text[SHEET_W / FONT_TILESZ + 1];
+    for(uint8_t i = 0; i < SHEET_W / FONT_TILESZ; i++) text[i] = '0' + (r * 16 + i) % 44;
+    text[SHEET_W / FONT_TILESZ] = 0;
+    tft.drawFont(0, r * FONT_TILESZ, text, 0x0010, ink[r]); // ink is the clear bits
+  }
+  Sheet s = { "font", model.screen(SHEET_W, SHEET_H) };
+  return s;
+}
+
+// flat areas, outlines and diagonals, the way a game's level tiles look
+static Sheet shapesSheet(void)
+{
+  tft.fillScreen(0x867D);
+  tft.fillRect(0, 40, SHEET_W, 24, 0x4A00);
+  tft.fillRect(0, 40, SHEET_W, 3, ST7735_GREEN);
+  for(int16_t r = 2; r < 14; r += 2) tft.drawCircle(20, 18, r, ST7735_YELLOW);
+  for(int16_t i = 0; i < 6; i++) {
+    tft.fillRect(50 + i * 12, 30 - i * 4, 10, 10 + i * 4, 0x8410);
+    tft.drawRect(50 + i * 12, 30 - i * 4, 10, 10 + i * 4, ST7735_BLACK);
+  }
+  for(int16_t x = 0; x < SHEET_W; x += 16) tft.drawLine(x, 63, x + 12, 48, 0x2100);
+  Sheet s = { "shapes", model.screen(SHEET_W, SHEET_H) };
+  return s;
+}
+
+// a speckled texture over 3 colours on top, 16 colour noise below
+static Sheet noiseSheet(void)
+{
+  static const uint16_t pal[16] = {
+    0x0000, 0x1082, 0x2104, 0x3186, 0x4208, 0x528A, 0x630C, 0x738E,
+    0x8410, 0x9492, 0xA514, 0xB596, 0xC618, 0xD69A, 0xE71C, 0xFFFF
+  };
+  uint32_t seed = 12345;
+  Sheet s = { "noise", std::vector<uint16_t>(SHEET_W * SHEET_H) };
+  for(int y = 0; y < SHEET_H; y++)
+    for(int x = 0; x < SHEET_W; x++) {
+      seed = seed * 1103515245 + 12345;
+      uint8_t r = seed >> 24;
+      uint16_t c;
+      if(y < SHEET_H / 2) c = (r < 180) ? pal[9] : (r < 230) ? pal[6] : pal[15];
+      else c = pal[r & 15];
+      s.rgb[y * SHEET_W + x] = c;
+    }
+  return s;
+}
+
+struct Packed {
+  std::vector<uint8_t>  data;
+  std::vector<uint16_t> addr; // tileAddr: format and count, then offsets
+};
+
+static Packed encode(const std::vector<std::vector<uint8_t> > &tiles, uint8_t fmt)
+{
+  Packed p;
+  p.addr.push_back((fmt << 8) | tiles.size());
+  for(size_t t = 0; t < tiles.size(); t++) {
+    Encoded e = (fmt == ST7735_RLE_V1) ? rleV1(tiles[t]) : (fmt == ST7735_RLE_V2) ? rleV2(tiles[t]) : rleV3(tiles[t]);
+    p.addr.push_back(p.data.size());
+    p.data.insert(p.data.end(), e.data.begin(), e.data.end());
+  }
+  return p;
+}
+
+static void bench(const Sheet &sheet)
+{
+  // palette in first use order, tiles as index vectors
+  std::vector<uint16_t> pal;
+  std::vector<std::vector<uint8_t> > tiles(TILES);
+  for(int t = 0; t < TILES; t++) {
+    int ox = (t % (SHEET_W / TILE)) * TILE, oy = (t / (SHEET_W / TILE)) * TILE;
+    for(int y = 0; y < TILE; y++)
+      for(int x = 0; x < TILE; x++) {
+        uint16_t c = sheet.rgb[(oy + y) * SHEET_W + ox + x];
+        size_t i = std::find(pal.begin(), pal.end(), c) - pal.begin();
+        if(i == pal.size()) pal.push_back(c);
+        tiles[t].push_back(i);
+      }
+  }
+  CHECK(pal.size() <= 16);
+  pal.resize(16, 0);
+
+  std::vector<uint8_t> firstStream;
+  for(uint8_t fmt = ST7735_RLE_V1; fmt <= ST7735_RLE_V3; fmt++) {
+    Packed p = encode(tiles, fmt);
+
+    // drawn, the sheet comes back pixel for pixel
+    tft.fillScreen(ST7735_BLUE);
+    model.clearLog();
+    for(uint8_t t = 0; t < TILES; t++)
+      tft.drawCBMPsectionRLE((t % (SHEET_W / TILE)) * TILE, (t / (SHEET_W / TILE)) * TILE, TILE, TILE,
+                             p.data.data(), p.addr.data(), pal.data(), TILE, TILE, t, false, false);
+    CHECK(model.screen(SHEET_W, SHEET_H) == sheet.rgb);
+    if(fmt == ST7735_RLE_V1) firstStream = model.ramBytes;
+    CHECK(model.ramBytes == firstStream);
+
+    // decoded, every tile matches the source
+    uint16_t out[TILE * TILE];
+    ST7735_RLEState s;
+    for(uint8_t t = 0; t < TILES; t++) {
+      tft.rleBegin(s, p.data.data(), p.addr.data(), t, pal.data());
+      tft.rleDecode(s, pal.data(), out, TILE * TILE);
+      bool same = true;
+      for(int i = 0; i < TILE * TILE; i++) same = same && (out[i] == pal[tiles[t][i]]);
+      CHECK(same);
+    }
+
+    // best of a few batches, the host is not quiet
+    double us = 0;
+    for(int b = 0; b < 5; b++) {
+      std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+      for(int r = 0; r < ROUNDS; r++)
+        for(uint8_t t = 0; t < TILES; t++) {
+          tft.rleBegin(s, p.data.data(), p.addr.data(), t, pal.data());
+          tft.rleDecode(s, pal.data(), out, TILE * TILE);
+        }
+      double batch = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / ROUNDS;
+      if(!b || batch < us) us = batch;
+    }
+
+    printf("%-7s V%u  %5u  %8.1f\n", sheet.name, fmt, (unsigned)p.data.size(), us);
+  }
+}
+
+int main()
+{
+  tft.initR(INITR_144GREENTAB);
+  model.ystart = 2;
+
+  printf("sheet   fmt  bytes  decode us  (%dx%d sheet, %dx%d tiles, %u pixel bytes)\n",
+         SHEET_W, SHEET_H, TILE, TILE, SHEET_W * SHEET_H * 2);
+  bench(fontSheet());
+  bench(shapesSheet());
+  bench(noiseSheet());
+  return hostDone("rlebench");
+}
@@ -0,0 +1,75 @@
+// Host stand-in for Adafruit_GFX: the members and virtuals the ST7735
+// driver and its helpers rely on, with GFX's own primitives built on
+// them the way the library does.  The classic 5x7 font is not included,
+// write() without a GFXfont draws nothing.
+
+#ifndef _ST7735_HOST_GFX_H_
+#define _ST7735_HOST_GFX_H_
+
+#include "Arduino.h"
+
+typedef struct {
+  uint16_t bitmapOffset;
+  uint8_t  width, height;
+  uint8_t  xAdvance;
+  int8_t   xOffset, yOffset;
+} GFXglyph;
+
+typedef struct {
+  uint8_t  *bitmap;
+  GFXglyph *glyph;
+  uint8_t   first, last;
+  uint8_t   yAdvance;
+} GFXfont;
+
+class Adafruit_GFX : public Print {
+
+ public:
+
+  Adafruit_GFX(int16_t w, int16_t h);
+
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+  virtual void startWrite(void),
+               writePixel(int16_t x, int16_t y, uint16_t color),
+               writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
+               writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color),
+               writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color),
+               writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color),
+               endWrite(void);
+
+  virtual void setRotation(uint8_t r),
+               invertDisplay(boolean i),
+               drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color),
+               drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color),
+               fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
+               fillScreen(uint16_t color),
+               drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
+       drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color),
+       setCursor(int16_t x, int16_t y),
+       setTextColor(uint16_t c),
+       setTextColor(uint16_t c, uint16_t bg),
+       setTextWrap(boolean w),
+       setFont(const GFXfont *f = NULL);
+
+  virtual size_t write(uint8_t c);
+  using Print::write;
+
+  int16_t width(void) const  { return _width; }
+  int16_t height(void) const { return _height; }
+  uint8_t getRotation(void) const { return rotation; }
+  int16_t getCursorX(void) const { return cursor_x; }
+  int16_t getCursorY(void) const { return cursor_y; }
+
+ protected:
+  const int16_t WIDTH, HEIGHT;
+  int16_t  _width, _height, cursor_x, cursor_y;
+  uint16_t textcolor, textbgcolor;
+  uint8_t  textsize, rotation;
+  boolean  wrap;
+  GFXfont *gfxFont;
+};
+
+#endif
@@ -0,0 +1,76 @@
+// Host stand-in for the Arduino core, just what the ST7735 driver uses.
+// Pins are plain numbers, every pin is its own one-bit port so the
+// driver's fast-IO paths run too, and every level change is reported to
+// the controller model (see host.h).
+
+#ifndef _ST7735_HOST_ARDUINO_H_
+#define _ST7735_HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+#define HIGH     1
+#define LOW      0
+#define INPUT    0
+#define OUTPUT   1
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define PROGMEM
+#define F(string_literal) string_literal
+
+#define ST7735_HOST_PINS 64
+
+// One output port per pin, bit 0 is the pin.  The driver only ever sets,
+// clears or flips it through the pin mask.
+struct ST7735_HostPort {
+  uint8_t level;
+  void operator|=(uint32_t m) volatile { set(level | (m & 1)); }
+  void operator&=(uint32_t m) volatile { set(level & (m & 1)); }
+  void operator^=(uint32_t m) volatile { set(level ^ (m & 1)); }
+  void set(uint8_t l) volatile; // host.cpp
+};
+extern volatile ST7735_HostPort hostPorts[ST7735_HOST_PINS];
+
+typedef volatile ST7735_HostPort RwReg;
+#define USE_FAST_IO
+
+#define digitalPinToPort(p)    (p)
+#define digitalPinToBitMask(p) 1
+#define portOutputRegister(p)  (&hostPorts[p])
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t level);
+void delay(unsigned long ms);
+unsigned long millis(void);
+unsigned long micros(void);
+
+class String {
+ public:
+  String(const char *s = "") : _s(s) {}
+  unsigned int length(void) const { return _s.size(); }
+  char operator[](unsigned int i) const { return _s[i]; }
+  const char *c_str(void) const { return _s.c_str(); }
+ private:
+  std::string _s;
+};
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buf, size_t n) {
+    size_t r = 0;
+    while(n--) r += write(*buf++);
+    return r;
+  }
+  size_t print(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+};
+
+#endif
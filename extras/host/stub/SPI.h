@@ -0,0 +1,32 @@
+// Host stand-in for the Arduino SPI library.  transfer() hands every byte
+// to the controller model and counts the calls (see host.h).
+
+#ifndef _ST7735_HOST_SPI_H_
+#define _ST7735_HOST_SPI_H_
+
+#include "Arduino.h"
+
+#define SPI_HAS_TRANSACTION
+#define SPI_MODE0 0x00
+#define SPI_CLOCK_DIV2 0x04
+
+class SPISettings {
+ public:
+  SPISettings() {}
+  SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) {}
+};
+
+class SPIClass {
+ public:
+  void    begin(void),
+          beginTransaction(SPISettings s),
+          endTransaction(void),
+          setClockDivider(uint8_t div),
+          setDataMode(uint8_t mode);
+  uint8_t transfer(uint8_t c);
+  void    transfer(void *buf, size_t n); // overwrites buf like the real thing
+};
+
+extern SPIClass SPI;
+
+#endif
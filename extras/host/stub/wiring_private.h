@@ -0,0 +1 @@
+// Host build: nothing needed from the core here.
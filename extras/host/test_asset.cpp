@@ -0,0 +1,70 @@
+// assetc round trip: asset_sheet.ppm compiled by assetc (see the
+// Makefile), once for the default flash/speed balance and once for the
+// least flash, so the tiles between them come out in every format assetc
+// writes.  drawAsset() of every tile, flipped and turned every way and
+// clipped at the screen edges, must show the PPM's own pixels.
+
+#include "host.h"
+#include "assetc.h"
+#include "asset_sheet.h"
+#include "asset_small.h"
+
+static Adafruit_ST7735 tft(TFT_CS, TFT_DC, TFT_RST);
+
+// the panel after drawing tile t of img over MAGENTA at x, y: flips first,
+// then a clockwise turn, as startOriented() does
+static std::vector<uint16_t> expected(const Image &img, const ST7735_Asset &a, uint8_t t,
+                                      int16_t x, int16_t y, bool flipH, bool flipV, bool rot90)
+{
+  std::vector<uint16_t> s(128 * 128, ST7735_MAGENTA);
+  int cols = img.w / a.tileW;
+  int ox = (t % cols) * a.tileW, oy = (t / cols) * a.tileH;
+  for(int sy = 0; sy < a.tileH; sy++)
+    for(int sx = 0; sx < a.tileW; sx++) {
+      int fx = flipH ? a.tileW - 1 - sx : sx;
+      int fy = flipV ? a.tileH - 1 - sy : sy;
+      int dx = rot90 ? a.tileH - 1 - fy : fx;
+      int dy = rot90 ? fx : fy;
+      if((x + dx < 0) || (y + dy < 0) || (x + dx >= 128) || (y + dy >= 128)) continue;
+      s[(y + dy) * 128 + x + dx] = to565(img.rgb[(oy + sy) * img.w + ox + sx]);
+    }
+  return s;
+}
+
+static void roundTrip(const Image &img, const ST7735_Asset &a)
+{
+  static const int16_t at[3][2] = { { 20, 30 }, { -3, -2 }, { 123, 124 } };
+  CHECK(a.count == (img.w / a.tileW) * (img.h / a.tileH));
+  for(uint8_t t = 0; t < a.count; t++)
+    for(uint8_t o = 0; o < 8; o++)
+      for(uint8_t p = 0; p < 3; p++) {
+        bool flipH = o & 1, flipV = o & 2, rot90 = o & 4;
+        tft.fillScreen(ST7735_MAGENTA);
+        tft.drawAsset(at[p][0], at[p][1], a, t, flipH, flipV, rot90);
+        if(model.screen(128, 128) != expected(img, a, t, at[p][0], at[p][1], flipH, flipV, rot90)) {
+          printf("tile %u (format 0x%02X) at %d,%d flipH %d flipV %d rot90 %d\n", t, pgm_read_byte(&a.format[t]),
+                 at[p][0], at[p][1], flipH, flipV, rot90);
+          CHECK(false);
+        }
+      }
+}
+
+int main()
+{
+  Image img = readPPM(readFile("asset_sheet.ppm"));
+  tft.initR(INITR_144GREENTAB);
+  model.ystart = 2;
+
+  roundTrip(img, sheet);
+  roundTrip(img, sheetSmall);
+  CHECK(model.errors == 0);
+
+  // between them the two builds use every format
+  uint8_t seen[0x40] = { 0 };
+  for(uint8_t t = 0; t < sheet.count; t++) seen[sheet_format[t]] = 1;
+  for(uint8_t t = 0; t < sheetSmall.count; t++) seen[sheetSmall_format[t]] = 1;
+  CHECK(seen[1] && seen[ST7735_PACKED2] && seen[ST7735_PACKED4]);
+  CHECK(seen[ST7735_ASSET_RLE | ST7735_RLE_V1] && seen[ST7735_ASSET_RLE | ST7735_RLE_V2] && seen[ST7735_ASSET_RLE | ST7735_RLE_V3]);
+
+  return hostDone("test_asset");
+}
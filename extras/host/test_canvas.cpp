@@ -0,0 +1,78 @@
+// ST7735_Canvas: drawing honours setRotation() the way GFXcanvas16 does,
+// and a flush with the shadow sends only the changed spans of each row.
+
+#include "host.h"
+#include "ST7735_Canvas.h"
+
+static Adafruit_ST7735 tft(TFT_CS, TFT_DC, TFT_RST);
+
+// drawn inside w x h, out to its far edges
+template<class Display>
+static void scene(Display &d, int16_t w, int16_t h)
+{
+  d.fillRect(0, 0, w, h, ST7735_BLACK);
+  d.drawPixel(0, 0, ST7735_CYAN);
+  d.drawPixel(w - 2, h - 3, ST7735_RED);
+  d.fillRect(20, 30, 7, 3, ST7735_GREEN);
+  d.drawFastHLine(0, h - 1, w, ST7735_BLUE);
+  d.drawFastVLine(w - 1, 2, h - 10, ST7735_YELLOW);
+  d.drawLine(3, h - 20, w - 5, 10, ST7735_WHITE);
+}
+
+int main()
+{
+  tft.initR(INITR_144GREENTAB);
+  model.ystart = 2;
+
+  // every rotation of a 100x60 canvas: flushed to the panel it shows what
+  // drawing straight to the panel does, and the buffer stays unrotated
+  static const int16_t rawX[4] = { 0, 99, 99, 0 }, rawY[4] = { 0, 0, 59, 59 };
+  for(uint8_t rot = 0; rot < 4; rot++) {
+    ST7735_Canvas c(100, 60);
+    CHECK(c.begin(true));
+    c.setRotation(rot);
+    CHECK(c.width() == ((rot & 1) ? 60 : 100));
+
+    tft.fillScreen(ST7735_MAGENTA);
+    scene(tft, c.width(), c.height());
+    std::vector<uint16_t> want = model.screen(128, 128);
+    tft.fillScreen(ST7735_MAGENTA);
+
+    scene(c, c.width(), c.height());
+    CHECK(c.getBuffer()[rawY[rot] * 100 + rawX[rot]] == ST7735_CYAN);
+    c.flush(tft);
+    CHECK(model.screen(128, 128) == want);
+    CHECK(model.errors == 0);
+    if(model.screen(128, 128) != want) printf("  at rotation %u\n", rot);
+  }
+
+  // redrawing a band with the same pixels and changing a few: only those
+  // go out, nearby ones in one span with the pixels between them
+  ST7735_Canvas c(128, 128);
+  CHECK(c.begin(true));
+  scene(c, 128, 128);
+  c.flush(tft);
+  c.fillRect(0, 40, 128, 20, ST7735_BLACK);
+  c.drawFastVLine(127, 2, 118, ST7735_YELLOW); // what the band covered
+  c.drawLine(3, 108, 123, 10, ST7735_WHITE);
+  c.drawPixel(3, 45, ST7735_RED);
+  c.drawPixel(90, 45, ST7735_RED);
+  c.drawPixel(50, 55, ST7735_BLUE);
+  c.drawPixel(10, 47, ST7735_BLUE);
+  c.drawPixel(13, 47, ST7735_BLUE);
+  model.clearLog();
+  c.flush(tft);
+  CHECK(model.pixels == 3 + 4);
+  CHECK(model.transactions == 1);
+  CHECK(model.at(3, 45) == ST7735_RED && model.at(90, 45) == ST7735_RED);
+  CHECK(model.at(50, 55) == ST7735_BLUE && model.at(13, 47) == ST7735_BLUE);
+
+  // nothing changed, nothing sent
+  c.fillRect(20, 30, 7, 3, ST7735_GREEN);
+  model.clearLog();
+  c.flush(tft);
+  CHECK(model.log.empty());
+  CHECK(model.errors == 0);
+
+  return hostDone("test_canvas");
+}
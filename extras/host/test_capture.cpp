@@ -0,0 +1,56 @@
+// Transport policies: the driver over ST7735_CaptureSPI must put exactly
+// the bytes on the bus that the hardware SPI driver does, and the capture
+// log must agree with what the controller model decoded.
+
+#include "host.h"
+
+static Adafruit_ST7735 tft(TFT_CS, TFT_DC, TFT_RST);
+static Adafruit_ST7735T<ST7735_CaptureSPI> cap(TFT_CS, TFT_DC, TFT_RST);
+
+static void toModel(uint8_t c) { model.byte(c); }
+
+template<class Display>
+static std::vector<uint16_t> scene(Display &d)
+{
+  model.reset();
+  d.initR(INITR_144GREENTAB);
+  d.fillScreen(ST7735_BLUE);
+  d.fillRect(10, 12, 30, 7, ST7735_RED);
+  d.drawFastHLine(0, 64, 128, ST7735_WHITE);
+  d.drawLine(3, 100, 90, 20, ST7735_GREEN);
+  d.setRotation(1);
+  d.drawPixel(5, 5, 0x1234);
+  d.startDraw(20, 20, 24, 21);
+  d.pushColorRepeat(0xABCD, 7);
+  d.pushColor(0x4321);
+  d.pushColorRepeat(0x0F0F, 2);
+  d.endDraw();
+  return model.log;
+}
+
+int main()
+{
+  std::vector<uint16_t> hw = scene(tft);
+  CHECK(model.errors == 0);
+  std::vector<uint16_t> hwScreen = model.screen(128, 128);
+  uint32_t hwFrames = model.transactions;
+
+  cap.transport().tap = toModel;
+  std::vector<uint16_t> sw = scene(cap);
+  CHECK(model.errors == 0);
+  CHECK(sw == hw);
+  CHECK(model.screen(128, 128) == hwScreen);
+  CHECK(model.transactions == 0); // nothing went near the SPI library
+
+  ST7735_CaptureSPI &bus = cap.transport();
+  CHECK(bus.bytes.size() == hw.size());
+  bool same = bus.bytes.size() == hw.size();
+  for(size_t i = 0; same && i < hw.size(); i++) same = (bus.bytes[i] == (hw[i] & 0xFF));
+  CHECK(same);
+  CHECK(bus.frames == hwFrames);
+  CHECK(bus.bufWrites > 0);
+  printf("capture: %u bytes in %u frames, %u byte and %u buffer writes\n",
+         (unsigned)bus.bytes.size(), (unsigned)bus.frames, (unsigned)bus.writes, (unsigned)bus.bufWrites);
+
+  return hostDone("test_capture");
+}
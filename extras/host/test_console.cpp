@@ -0,0 +1,102 @@
+// ST7735_Console: once the area is full every new line only blanks the
+// oldest slot and moves VSCRSADD, and what the panel shows through the
+// scroll is always the last lines in order, however many times the ring
+// has wrapped round.  Rotations 0 and 2, which scroll opposite ways
+// through GRAM.
+
+#include "host.h"
+#include "ST7735_Console.h"
+#include <string>
+
+static Adafruit_ST7735 tft(TFT_CS, TFT_DC, TFT_RST);
+
+#define TOP   16
+#define LINES 6
+#define COLS  (128 / FONT_TILESZ)
+
+// tileFont pixel gx, gy of character c as drawFont() draws it by default
+static uint16_t glyphAt(char c, uint8_t gx, uint8_t gy)
+{
+  uint8_t tile = (uint8_t)(c - 48);
+  if(tile > 50) tile = 11;
+  uint8_t bits = pgm_read_byte(&tileFont[tile * FONT_TILESZ + gy]);
+  return pgm_read_word(&fontCol[(bits & (0x80 >> gx)) ? 0 : 1]);
+}
+
+// the console area as it should look with these lines, top one first
+static std::vector<uint16_t> expected(const std::vector<std::string> &lines)
+{
+  std::vector<uint16_t> s;
+  for(int16_t y = 0; y < LINES * FONT_TILESZ; y++)
+    for(int16_t x = 0; x < 128; x++) {
+      size_t l = y / FONT_TILESZ;
+      size_t col = x / FONT_TILESZ;
+      char c = ((l < lines.size()) && (col < lines[l].size())) ? lines[l][col] : ' ';
+      s.push_back(glyphAt(c, x % FONT_TILESZ, y % FONT_TILESZ));
+    }
+  return s;
+}
+
+static std::vector<uint16_t> area(void)
+{
+  std::vector<uint16_t> s;
+  for(int16_t y = TOP; y < TOP + LINES * FONT_TILESZ; y++)
+    for(int16_t x = 0; x < 128; x++) s.push_back(model.shown(x, y));
+  return s;
+}
+
+static void scroll(uint8_t rot)
+{
+  tft.setRotation(rot);
+  tft.fillScreen(ST7735_RED);
+  ST7735_Console con(tft, TOP, LINES);
+  CHECK(con.begin());
+  CHECK(model.vsa == LINES * FONT_TILESZ);
+
+  std::vector<std::string> all;
+  for(int n = 0; n < 3 * LINES + 2; n++) {
+    char text[COLS + 1];
+    snprintf(text, sizeof(text), "%d:%02d=%X", rot, n, n * 37);
+    if(n) con.write('\n');
+    model.clearLog();
+    con.print(text);
+    all.push_back(text);
+
+    std::vector<std::string> last(all.end() - std::min<size_t>(all.size(), LINES), all.end());
+    CHECK(area() == expected(last));
+    // at most the one line drawn, nothing else resent
+    CHECK(model.ramBytes.size() <= strlen(text) * FONT_TILESZ * FONT_TILESZ * 2);
+  }
+
+  // a new line on a full area blanks the oldest slot and scrolls: one
+  // line of pixels and one VSCRSADD
+  model.clearLog();
+  con.write('\n');
+  CHECK(model.ramBytes.size() == COLS * FONT_TILESZ * FONT_TILESZ * 2);
+  CHECK(std::count(model.log.begin(), model.log.end(), ST7735_VSCRSADD) == 1);
+  all.push_back("");
+  std::vector<std::string> last(all.end() - LINES, all.end());
+  CHECK(area() == expected(last));
+
+  // rows outside the area do not move
+  for(int16_t x = 0; x < 128; x += 7) {
+    CHECK(model.shown(x, TOP - 1) == ST7735_RED);
+    CHECK(model.shown(x, TOP + LINES * FONT_TILESZ) == ST7735_RED);
+    CHECK(model.shown(x, 127) == ST7735_RED);
+  }
+
+  // redraw() repaints the ring where the scroll expects it
+  tft.fillRect(0, TOP, 128, LINES * FONT_TILESZ, ST7735_BLUE);
+  con.redraw();
+  CHECK(area() == expected(last));
+  CHECK(model.errors == 0);
+}
+
+int main()
+{
+  tft.initR(INITR_144GREENTAB);
+  model.ystart = 2;
+  scroll(0);
+  scroll(2);
+  return hostDone("test_console");
+}
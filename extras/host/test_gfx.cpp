@@ -0,0 +1,54 @@
+// Adafruit_GFX write API: GFX wraps every primitive in startWrite() and
+// endWrite(), so a line, circle or rectangle is one bus transaction and
+// one CS frame however many pixels and spans it is made of.
+
+#include "host.h"
+
+static Adafruit_ST7735 tft(TFT_CS, TFT_DC, TFT_RST);
+
+static void once(const char *what)
+{
+  if((model.transactions != 1) || (model.csFrames != 1))
+    printf("%s: %u transactions, %u CS frames\n", what, (unsigned)model.transactions, (unsigned)model.csFrames);
+  CHECK(model.transactions == 1);
+  CHECK(model.csFrames == 1);
+  CHECK(model.errors == 0);
+  model.clearLog();
+}
+
+int main()
+{
+  tft.initR(INITR_144GREENTAB);
+  model.ystart = 2;
+  tft.fillScreen(ST7735_BLACK);
+  model.clearLog();
+
+  tft.drawLine(3, 100, 90, 20, ST7735_GREEN);
+  once("drawLine");
+  CHECK(model.at(3, 100) == ST7735_GREEN);
+  CHECK(model.at(90, 20) == ST7735_GREEN);
+
+  tft.drawCircle(64, 64, 30, ST7735_RED);
+  once("drawCircle");
+  CHECK(model.at(64, 34) == ST7735_RED);
+  CHECK(model.at(94, 64) == ST7735_RED);
+  CHECK(model.at(64, 64) == ST7735_BLACK);
+
+  tft.drawRect(10, 12, 30, 7, ST7735_WHITE);
+  once("drawRect");
+  CHECK(model.at(10, 12) == ST7735_WHITE);
+  CHECK(model.at(39, 18) == ST7735_WHITE);
+  CHECK(model.at(20, 15) == ST7735_BLACK);
+
+  // the same in the middle of a rotation, clipped at the edges
+  tft.setRotation(3);
+  model.clearLog();
+  tft.drawLine(-10, 5, 140, 60, ST7735_BLUE);
+  once("drawLine, clipped");
+  tft.drawCircle(0, 0, 20, ST7735_BLUE);
+  once("drawCircle, clipped");
+  tft.drawRect(100, 100, 40, 40, ST7735_BLUE);
+  once("drawRect, clipped");
+
+  return hostDone("test_gfx");
+}
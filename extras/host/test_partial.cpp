@@ -0,0 +1,123 @@
+// Partial display mode: setPartialArea() shows only its rows, and every
+// draw call is clipped to them, so nothing lands in (or is sent for) the
+// rows the panel does not refresh.  normalDisplay() drops the clip, and
+// idle mode shows 8 colours.  Rotations 0 and 2.
+
+#include "host.h"
+
+static Adafruit_ST7735 tft(TFT_CS, TFT_DC, TFT_RST);
+
+#define TOP 40
+#define H   30
+
+static uint8_t bitmap[] = { 0xFF, 0xFF, 0xFF, 0x88, 0x88 };
+static GFXglyph glyphs[] = {
+  { 0, 6, 4, 4,  0, -4 },
+  { 3, 4, 4, 4, -1, -4 },
+};
+static GFXfont font = { bitmap, glyphs, 'A', 'B', 6 };
+
+static const uint16_t pal[16] = {
+  0x0000, 0x1111, 0x2222, 0x3333, 0x4444, 0x5555, 0x6666, 0x7777,
+  0x8888, 0x9999, 0xAAAA, 0xBBBB, 0xCCCC, 0xDDDD, 0xEEEE, 0xFFFF
+};
+static uint8_t sheet[8 * 8 * 2];
+static const uint8_t tiles[] = { 0, 1, 0, 1, 1 };
+static const uint8_t aa[] = { 0x05, 0xAF, 0xFA, 0x50 };
+static const ST7735_AAFont aaFont = { 4, 2, 4, 'a', 1, aa };
+
+// everything crosses the band edges or sits wholly outside it
+static void scene(void)
+{
+  tft.fillScreen(ST7735_BLUE);
+  tft.fillRect(10, 30, 20, 20, ST7735_RED);
+  tft.fillRect(10, 100, 20, 20, ST7735_RED);
+  tft.drawFastVLine(50, 0, 128, ST7735_GREEN);
+  tft.drawFastHLine(0, TOP - 1, 128, ST7735_GREEN);
+  tft.drawFastHLine(0, TOP + H, 128, ST7735_GREEN);
+  tft.drawFastHLine(0, TOP + 3, 128, ST7735_YELLOW);
+  tft.drawLine(0, 0, 127, 127, ST7735_WHITE);
+  tft.drawCircle(64, TOP, 12, ST7735_CYAN);
+  tft.drawPixel(3, TOP - 5, ST7735_WHITE);
+  tft.drawPixel(3, TOP + 5, ST7735_WHITE);
+  tft.drawFont(60, TOP - 4, "0123", ST7735_BLACK, ST7735_WHITE);
+  tft.drawText(90, TOP + 2, "AB", &font, ST7735_RED, ST7735_BLACK);
+  tft.drawCBMPsection(100, TOP + H - 4, 8, 8, sheet, pal, 16, 8, 1, false, false, 4);
+  tft.drawTiles(0, TOP + H - 2, 8, 8, tiles, 5, sheet, pal, 16);
+  tft.drawAAText(70, TOP + H - 1, "aaa", aaFont);
+}
+
+static void partial(uint8_t rot)
+{
+  tft.setRotation(rot);
+  tft.normalDisplay();
+  tft.fillScreen(ST7735_MAGENTA);
+  scene();
+  std::vector<uint16_t> full = model.screen(128, 128);
+
+  tft.fillScreen(ST7735_MAGENTA);
+  tft.setPartialArea(TOP, H);
+  model.clearLog();
+  scene();
+  std::vector<uint16_t> got = model.screen(128, 128);
+  bool inBand = true, outside = true;
+  for(int16_t y = 0; y < 128; y++)
+    for(int16_t x = 0; x < 128; x++) {
+      uint16_t c = got[y * 128 + x];
+      if((y >= TOP) && (y < TOP + H)) inBand = inBand && (c == full[y * 128 + x]);
+      else outside = outside && (c == ST7735_MAGENTA);
+    }
+  CHECK(inBand);
+  CHECK(outside);
+  CHECK(model.errors == 0);
+
+  // drawing wholly outside the band sends nothing at all
+  model.clearLog();
+  tft.fillRect(0, 0, 128, TOP, ST7735_RED);
+  tft.drawPixel(5, TOP + H, ST7735_RED);
+  tft.drawFastHLine(0, 127, 128, ST7735_RED);
+  tft.drawFont(0, 0, "0123", ST7735_BLACK, ST7735_WHITE);
+  tft.drawTiles(0, TOP + H, 8, 8, tiles, 5, sheet, pal, 16);
+  CHECK(model.log.empty());
+
+  // and a full screen fill only the band's pixels
+  model.clearLog();
+  tft.fillScreen(ST7735_GREEN);
+  CHECK(model.pixels == 128 * H);
+
+  // the panel shows the band and nothing else
+  CHECK(model.partial);
+  for(int16_t x = 0; x < 128; x += 9) {
+    CHECK(model.shown(x, TOP) == ST7735_GREEN);
+    CHECK(model.shown(x, TOP + H - 1) == ST7735_GREEN);
+    CHECK(model.shown(x, TOP - 1) == 0x0000);
+    CHECK(model.shown(x, TOP + H) == 0x0000);
+  }
+
+  // idle mode: 8 colours, the top bit of each channel
+  tft.fillRect(0, TOP, 64, H, 0x8410);
+  tft.fillRect(64, TOP, 64, H, 0x7BEF);
+  tft.idleMode(true);
+  CHECK(model.shown(10, TOP + 1) == ST7735_WHITE);
+  CHECK(model.shown(100, TOP + 1) == 0x0000);
+  tft.idleMode(false);
+  CHECK(model.shown(10, TOP + 1) == 0x8410);
+
+  // back to normal the whole screen draws again
+  tft.normalDisplay();
+  CHECK(!model.partial);
+  tft.fillScreen(ST7735_MAGENTA);
+  scene();
+  CHECK(model.screen(128, 128) == full);
+  CHECK(model.errors == 0);
+}
+
+int main()
+{
+  for(uint8_t i = 0; i < sizeof(sheet); i++) sheet[i] = (i * 7 + i / 16) & 15;
+  tft.initR(INITR_144GREENTAB);
+  model.ystart = 2;
+  partial(0);
+  partial(2);
+  return hostDone("test_partial");
+}
@@ -0,0 +1,233 @@
+// Bulk pixel stream: every fill and blit path must put the same pixel
+// bytes on the bus as drawing one pixel at a time did, in far fewer SPI
+// calls.
+
+#include "host.h"
+
+static Adafruit_ST7735 tft(TFT_CS, TFT_DC, TFT_RST);
+
+static const uint16_t pal[16] PROGMEM = {
+  0x0000, 0xF800, 0x07E0, 0x001F, 0xFFE0, 0xF81F, 0x07FF, 0xFFFF,
+  0x1234, 0x4321, 0x8888, 0x0F0F, 0xA5A5, 0x5A5A, 0x3C3C, 0xC3C3
+};
+
+// 13x6 mono bitmap, rows padded to two bytes
+static const uint8_t mono[] PROGMEM = {
+  0xF0, 0x18, 0x81, 0x00, 0xAA, 0xA8, 0x55, 0x50, 0x0F, 0xF8, 0x12, 0x30
+};
+
+// two 8x4 tiles side by side, one palette index per byte
+static uint8_t sheet[4 * 16];
+
+// one 8x4 RLE V1 tile: colour << 4 | (length - 1)
+static const uint8_t rle[] PROGMEM = { 0x37, 0x15, 0x21, 0x7D, 0x91 };
+static const uint16_t rleAddr[] PROGMEM = { 1, 0 };
+
+static std::vector<uint16_t> region(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  std::vector<uint16_t> r;
+  for(int16_t j = 0; j < h; j++)
+    for(int16_t i = 0; i < w; i++) r.push_back(model.at(x + i, y + j));
+  return r;
+}
+
+// Draw img one drawPixel() at a time, the old per-pixel path, and return
+// the pixel bytes that went out.
+static std::vector<uint8_t> perPixel(int16_t x, int16_t y, int16_t w, int16_t h, const std::vector<uint16_t> &img)
+{
+  tft.fillRect(x, y, w, h, 0xDEAD);
+  model.clearLog();
+  for(int16_t j = 0; j < h; j++)
+    for(int16_t i = 0; i < w; i++) tft.drawPixel(x + i, y + j, img[j * w + i]);
+  return model.ramBytes;
+}
+
+static std::vector<uint8_t> bigEndian(const std::vector<uint16_t> &img)
+{
+  std::vector<uint8_t> b;
+  for(size_t i = 0; i < img.size(); i++) {
+    b.push_back(img[i] >> 8);
+    b.push_back(img[i]);
+  }
+  return b;
+}
+
+// The bulk draw left in the model log must match the per-pixel one.
+static void sameAsPerPixel(const char *what, int16_t x, int16_t y, int16_t w, int16_t h, const std::vector<uint16_t> &img)
+{
+  std::vector<uint8_t> bulk = model.ramBytes;
+  int before = hostFailures;
+  CHECK(region(x, y, w, h) == img);
+  CHECK(bulk == bigEndian(img));
+  CHECK(perPixel(x, y, w, h, img) == bulk);
+  CHECK(region(x, y, w, h) == img);
+  if(hostFailures != before) printf("  in %s\n", what);
+}
+
+int main()
+{
+  tft.initR(INITR_144GREENTAB);
+  model.ystart = 2; // green 1.44" tab, rotation 0
+  CHECK(model.errors == 0);
+
+  // fillScreen: one window and a chunked repeat
+  uint32_t bytes = 128 * 128 * 2;
+  model.clearLog();
+  tft.fillScreen(0x1234);
+  CHECK(model.ramBytes.size() == bytes);
+  CHECK(model.ramBytes == bigEndian(std::vector<uint16_t>(128 * 128, 0x1234)));
+  CHECK(model.screen(128, 128) == std::vector<uint16_t>(128 * 128, 0x1234));
+  CHECK(model.csFrames == 1);
+  CHECK(model.spiBufCalls == bytes / ST7735_PUSH_CHUNK);
+  CHECK(model.spiByteCalls <= 11); // CASET, RASET, RAMWR and their arguments
+  printf("fillScreen: %u bytes in %u SPI calls (%u at one call per byte)\n",
+         (unsigned)model.log.size(), (unsigned)(model.spiBufCalls + model.spiByteCalls), (unsigned)model.log.size());
+
+  // fills
+  model.clearLog();
+  tft.fillRect(3, 4, 37, 5, 0xF81F);
+  sameAsPerPixel("fillRect", 3, 4, 37, 5, std::vector<uint16_t>(37 * 5, 0xF81F));
+  CHECK(model.errors == 0);
+
+  model.clearLog();
+  tft.drawFastHLine(0, 100, 128, 0x07E0);
+  sameAsPerPixel("drawFastHLine", 0, 100, 128, 1, std::vector<uint16_t>(128, 0x07E0));
+
+  model.clearLog();
+  tft.drawFastVLine(60, 10, 90, 0x001F);
+  sameAsPerPixel("drawFastVLine", 60, 10, 1, 90, std::vector<uint16_t>(90, 0x001F));
+
+  // clipped fill only sends what is on screen
+  model.clearLog();
+  tft.fillRect(120, 120, 20, 20, 0xAAAA);
+  CHECK(model.ramBytes.size() == 8 * 8 * 2);
+  CHECK(region(120, 120, 8, 8) == std::vector<uint16_t>(64, 0xAAAA));
+
+  // pushColors / pushBytes straight through
+  std::vector<uint16_t> grad;
+  for(uint16_t i = 0; i < 30; i++) grad.push_back(i * 0x0841);
+  model.clearLog();
+  tft.startDraw(5, 7, 14, 9);
+  tft.pushColors(&grad[0], grad.size());
+  tft.endDraw();
+  CHECK(model.ramBytes == bigEndian(grad));
+  CHECK(region(5, 7, 10, 3) == grad);
+  CHECK(model.spiBufCalls == 2);
+
+  std::vector<uint8_t> raw = bigEndian(grad);
+  std::reverse(raw.begin(), raw.end());
+  model.clearLog();
+  tft.startDraw(5, 7, 14, 9);
+  tft.pushBytes(&raw[0], raw.size());
+  tft.endDraw();
+  CHECK(model.ramBytes == raw);
+  CHECK(model.spiBufCalls == 2);
+
+  // odd repeat counts across chunk boundaries
+  model.clearLog();
+  tft.startDraw(0, 0, 127, 0);
+  tft.pushColorRepeat(0x0102, 17);
+  tft.pushColorRepeat(0x0304, 111);
+  tft.endDraw();
+  std::vector<uint16_t> rep(17, 0x0102);
+  rep.insert(rep.end(), 111, 0x0304);
+  CHECK(model.ramBytes == bigEndian(rep));
+
+  // mono bitmap
+  std::vector<uint16_t> img;
+  for(int16_t j = 0; j < 6; j++)
+    for(int16_t i = 0; i < 13; i++)
+      img.push_back((mono[j * 2 + i / 8] & (0x80 >> (i & 7))) ? 0xFFE0 : 0x0010);
+  model.clearLog();
+  tft.drawFastBitmap(30, 40, mono, 13, 6, 0xFFE0, 0x0010);
+  sameAsPerPixel("drawFastBitmap", 30, 40, 13, 6, img);
+
+  // colour index sections, one byte per pixel, and 1 bit (rows of an 8
+  // wide tile are one byte)
+  for(uint8_t i = 0; i < sizeof(sheet); i++) sheet[i] = (i * 7 + i / 16) & 15;
+  img.clear();
+  for(int16_t j = 0; j < 4; j++)
+    for(int16_t i = 0; i < 8; i++) img.push_back(pal[sheet[j * 16 + 8 + i]]);
+  model.clearLog();
+  tft.drawCBMPsection(20, 30, 8, 4, sheet, pal, 16, 4, 1, false, false, 4);
+  sameAsPerPixel("drawCBMPsection 4", 20, 30, 8, 4, img);
+
+  // the same sheet packed two pixels per byte
+  uint8_t packed4[8 * 4];
+  for(uint8_t i = 0; i < sizeof(packed4); i++) packed4[i] = sheet[i * 2] << 4 | sheet[i * 2 + 1];
+  model.clearLog();
+  tft.drawCBMPsection(20, 30, 8, 4, packed4, pal, 16, 4, 1, false, false, ST7735_PACKED4);
+  sameAsPerPixel("drawCBMPsection PACKED4", 20, 30, 8, 4, img);
+
+  // four per byte, 12 wide with 3 wide tiles so tile 1 starts mid byte
+  uint8_t packed2[3 * 4];
+  for(uint8_t i = 0; i < sizeof(packed2); i++) {
+    uint8_t r = i / 3, c = i % 3 * 4;
+    packed2[i] = 0;
+    for(uint8_t q = 0; q < 4; q++) packed2[i] |= (sheet[r * 16 + c + q] & 3) << (6 - q * 2);
+  }
+  img.clear();
+  for(int16_t j = 0; j < 4; j++)
+    for(int16_t i = 0; i < 3; i++) img.push_back(pal[sheet[j * 16 + 3 + i] & 3]);
+  model.clearLog();
+  tft.drawCBMPsection(20, 30, 3, 4, packed2, pal, 12, 4, 1, false, false, ST7735_PACKED2);
+  sameAsPerPixel("drawCBMPsection PACKED2", 20, 30, 3, 4, img);
+
+  img.clear();
+  for(int16_t j = 0; j < 6; j++)
+    for(int16_t i = 0; i < 8; i++)
+      img.push_back((mono[j] & (0x80 >> i)) ? pal[0] : pal[1]);
+  model.clearLog();
+  tft.drawCBMPsection(50, 30, 8, 6, mono, pal, 16, 6, 0, false, false, 1);
+  sameAsPerPixel("drawCBMPsection 1", 50, 30, 8, 6, img);
+
+  // RLE
+  img.clear();
+  for(uint8_t p = 0; p < sizeof(rle); p++)
+    img.insert(img.end(), (rle[p] & 0xF) + 1, pal[rle[p] >> 4]);
+  CHECK(img.size() == 32);
+  model.clearLog();
+  tft.drawCBMPsectionRLE(70, 50, 8, 4, rle, rleAddr, pal, 8, 4, 0, false, false);
+  sameAsPerPixel("drawCBMPsectionRLE", 70, 50, 8, 4, img);
+  model.clearLog();
+  tft.drawCBMPsectionRLE(70, 50, 8, 4, rle, rleAddr, pal, 8, 4, 0, false, false);
+  CHECK(model.spiBufCalls <= sizeof(rle));
+
+  // RGB444: pixels pushed one at a time pair up, the odd one out is only
+  // padded when the draw ends
+  tft.setColorMode(COLOR_444);
+  model.clearLog();
+  tft.startDraw(0, 0, 3, 0);
+  tft.pushColor(ST7735_RED);
+  tft.pushColor(ST7735_GREEN);
+  tft.pushColor(ST7735_BLUE);
+  tft.pushColor(ST7735_WHITE);
+  tft.endDraw();
+  uint8_t rgbw[] = { 0xF0, 0x00, 0xF0, 0x00, 0xFF, 0xFF };
+  CHECK(model.ramBytes == std::vector<uint8_t>(rgbw, rgbw + sizeof(rgbw)));
+  CHECK(region(0, 0, 4, 1) == std::vector<uint16_t>({ 0xF00, 0x0F0, 0x00F, 0xFFF }));
+
+  model.clearLog();
+  tft.startDraw(0, 1, 2, 1);
+  tft.pushColor(ST7735_BLUE);
+  tft.pushColor(ST7735_RED);
+  tft.pushColor(ST7735_GREEN);
+  tft.endDraw();
+  uint8_t bgr[] = { 0x00, 0xFF, 0x00, 0x0F, 0x00 };
+  CHECK(model.ramBytes == std::vector<uint8_t>(bgr, bgr + sizeof(bgr)));
+  CHECK(region(0, 1, 3, 1) == std::vector<uint16_t>({ 0x00F, 0xF00, 0x0F0 }));
+
+  // raw bytes after an odd pixel start on a fresh byte
+  model.clearLog();
+  tft.startDraw(0, 2, 2, 2);
+  tft.pushColor(ST7735_WHITE);
+  uint8_t two[] = { 0x12, 0x34, 0x56 };
+  tft.pushBytes(two, sizeof(two));
+  tft.endDraw();
+  uint8_t wtwo[] = { 0xFF, 0xF0, 0x12, 0x34, 0x56 };
+  CHECK(model.ramBytes == std::vector<uint8_t>(wtwo, wtwo + sizeof(wtwo)));
+  tft.setColorMode(COLOR_565);
+
+  CHECK(model.errors == 0);
+  return hostDone("test_push");
+}
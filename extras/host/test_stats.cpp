@@ -0,0 +1,101 @@
+// ST7735_PROTOCOL_STATS: built with the flag (see the Makefile), the
+// driver's own counts of bytes, CS and DC writes must agree with what the
+// controller model saw over a graphicstest-like run, and a window that is
+// set up again unchanged must be credited with what the cache saved.
+
+#include "host.h"
+
+#if !defined(ST7735_PROTOCOL_STATS)
+#error test_stats needs -DST7735_PROTOCOL_STATS
+#endif
+
+static Adafruit_ST7735 tft(TFT_CS, TFT_DC, TFT_RST);
+
+// the counters must agree with the model since the last clearLog()
+static void agree(const char *what)
+{
+  const ST7735_Stats &s = tft.stats();
+  if((s.bytes != model.log.size()) || (s.csToggles != model.csWrites) || (s.dcToggles != model.dcWrites))
+    printf("%s: stats %u bytes, %u CS, %u DC; model %u bytes, %u CS, %u DC\n", what,
+           (unsigned)s.bytes, (unsigned)s.csToggles, (unsigned)s.dcToggles,
+           (unsigned)model.log.size(), (unsigned)model.csWrites, (unsigned)model.dcWrites);
+  CHECK(s.bytes == model.log.size());
+  CHECK(s.csToggles == model.csWrites);
+  CHECK(s.dcToggles == model.dcWrites);
+  CHECK(model.errors == 0);
+}
+
+static void graphicstest(void)
+{
+  tft.fillScreen(ST7735_BLACK);
+  for(int16_t y = 0; y < tft.height(); y += 5) tft.drawFastHLine(0, y, tft.width(), ST7735_RED);
+  for(int16_t x = 0; x < tft.width(); x += 5) tft.drawFastVLine(x, 0, tft.height(), ST7735_BLUE);
+  for(int16_t x = 0; x < tft.width(); x += 6) tft.drawLine(0, 0, x, tft.height() - 1, ST7735_YELLOW);
+  for(int16_t x = 0; x < tft.width(); x += 6) tft.drawRect(tft.width() / 2 - x / 2, tft.height() / 2 - x / 2, x, x, ST7735_GREEN);
+  for(int16_t x = tft.width() - 1; x > 6; x -= 6) tft.fillRect(tft.width() / 2 - x / 2, tft.height() / 2 - x / 2, x, x, ST7735_MAGENTA);
+  for(int16_t r = 2; r < 60; r += 7) tft.drawCircle(64, 64, r, ST7735_WHITE);
+  for(int16_t i = 0; i < 40; i++) tft.drawPixel(i * 3, i * 2, ST7735_CYAN);
+  tft.drawFont(4, 4, "0123ABC", ST7735_BLACK, ST7735_WHITE);
+  tft.startDraw(10, 10, 29, 19);
+  tft.pushColorRepeat(ST7735_RED, 150);
+  for(uint8_t i = 0; i < 50; i++) tft.pushColor(i * 0x0421);
+  tft.endDraw();
+  tft.invertDisplay(true);
+  tft.invertDisplay(false);
+}
+
+int main()
+{
+  tft.initR(INITR_144GREENTAB);
+  model.ystart = 2;
+
+  for(uint8_t rot = 0; rot < 4; rot++) {
+    tft.setRotation(rot);
+    tft.resetStats();
+    model.clearLog();
+    graphicstest();
+    agree("graphicstest");
+    CHECK(tft.stats().bytes > 0);
+  }
+
+  // 444 mode packs pixels, the counts still follow the bus
+  tft.setColorMode(COLOR_444);
+  tft.resetStats();
+  model.clearLog();
+  graphicstest();
+  agree("graphicstest, 444");
+  tft.setColorMode(COLOR_565);
+
+  // the same one pixel window twice: the second time CASET and RASET are
+  // skipped, only RAMWR and the pixel go out
+  tft.setRotation(0);
+  tft.drawPixel(1, 1, ST7735_RED);
+  tft.resetStats();
+  model.clearLog();
+  tft.drawPixel(7, 9, ST7735_RED);
+  ST7735_Stats first = tft.stats();
+  agree("first window");
+  CHECK(first.bytes == 13);
+  CHECK(first.bytesSaved == 0);
+
+  tft.drawPixel(7, 9, ST7735_GREEN);
+  ST7735_Stats again = tft.stats();
+  agree("repeated window");
+  CHECK(again.bytes - first.bytes == 3);
+  CHECK(again.dcToggles - first.dcToggles == 2);
+  CHECK(again.csToggles - first.csToggles == first.csToggles);
+  CHECK(again.bytesSaved - first.bytesSaved == 10);
+  // credited against the same one-write-per-byte cost as the first time,
+  // so the saving grows by just what the repeat did not send
+  CHECK((again.dcSaved - first.dcSaved) - first.dcSaved == first.dcToggles - (again.dcToggles - first.dcToggles));
+  CHECK(again.csSaved - first.csSaved == first.csSaved);
+  CHECK(model.at(7, 9) == ST7735_GREEN);
+
+  // same column, new row: only CASET is skipped
+  tft.resetStats();
+  tft.drawPixel(7, 10, ST7735_GREEN);
+  CHECK(tft.stats().bytesSaved == 5);
+  CHECK(tft.stats().bytes == 8);
+
+  return hostDone("test_stats");
+}
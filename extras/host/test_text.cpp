@@ -0,0 +1,120 @@
+// Opaque GFXfont print(): each glyph gets its own line box, but a glyph
+// printed straight after another must not paint background over the
+// part of its neighbour that overhangs into its cell.  Anti-aliased text
+// draws every coverage level in its step of the setAAColors() blend.
+
+#include "host.h"
+
+static Adafruit_ST7735 tft(TFT_CS, TFT_DC, TFT_RST);
+
+// 'A' is 6 wide on a 4 pixel advance, solid.  'B' starts one pixel left
+// of its pen and only inks its first column.
+static uint8_t bitmap[] = { 0xFF, 0xFF, 0xFF, 0x88, 0x88 };
+static GFXglyph glyphs[] = {
+  { 0, 6, 4, 4,  0, -4 },
+  { 3, 4, 4, 4, -1, -4 },
+};
+static GFXfont font = { bitmap, glyphs, 'A', 'B', 6 };
+
+// 4 x 2 anti-aliased glyphs 'a' and 'b'.  4 bit: a ramps 0, 5, 10, 15 and
+// back, b holds 1..4 over 11..14.  2 bit: a ramps 0..3 and back, b is
+// solid then clear.
+static const uint8_t aa4[] = { 0x05, 0xAF, 0xFA, 0x50, 0x12, 0x34, 0xBC, 0xDE };
+static const uint8_t aa2[] = { 0x1B, 0xE4, 0xFF, 0x00 };
+static const ST7735_AAFont font4 = { 4, 2, 4, 'a', 2, aa4 };
+static const ST7735_AAFont font2 = { 4, 2, 2, 'a', 2, aa2 };
+
+#define AA_FG 0xFD20
+#define AA_BG 0x0841
+
+// coverage c of 15 from AA_BG to AA_FG, rounded per channel
+static uint16_t blend(uint8_t c)
+{
+  uint16_t r = (((AA_FG >> 11) & 0x1F) * c + ((AA_BG >> 11) & 0x1F) * (15 - c) + 7) / 15;
+  uint16_t g = (((AA_FG >> 5) & 0x3F) * c + ((AA_BG >> 5) & 0x3F) * (15 - c) + 7) / 15;
+  uint16_t b = ((AA_FG & 0x1F) * c + (AA_BG & 0x1F) * (15 - c) + 7) / 15;
+  return (r << 11) | (g << 5) | b;
+}
+
+static std::vector<uint16_t> blends(std::vector<uint8_t> levels)
+{
+  std::vector<uint16_t> v;
+  for(size_t i = 0; i < levels.size(); i++) v.push_back(blend(levels[i]));
+  return v;
+}
+
+static std::vector<uint16_t> row(int16_t x, int16_t y, int16_t w)
+{
+  std::vector<uint16_t> r;
+  for(int16_t i = 0; i < w; i++) r.push_back(model.at(x + i, y));
+  return r;
+}
+
+int main()
+{
+  tft.initR(INITR_144GREENTAB);
+  model.ystart = 2;
+  tft.fillScreen(ST7735_WHITE);
+
+  tft.setFont(&font);
+  tft.setTextColor(ST7735_RED, ST7735_BLACK);
+  tft.setCursor(10, 20);
+  tft.print("AB");
+
+  // A inks 10..15, B inks 13; B's box only adds 16..17 of background
+  const uint16_t R = ST7735_RED, K = ST7735_BLACK, W = ST7735_WHITE;
+  std::vector<uint16_t> want = { W, R, R, R, R, R, R, K, K, W };
+  for(int16_t y = 16; y < 20; y++) CHECK(row(9, y, 10) == want);
+  CHECK(row(9, 15, 10) == std::vector<uint16_t>(10, W));
+
+  // after setCursor() the box is drawn whole again: B at 13 inks 12 and
+  // clears 13..16, over A's ink
+  tft.setCursor(13, 20);
+  tft.print("B");
+  std::vector<uint16_t> over = { W, R, R, R, K, K, K, K, K, W };
+  for(int16_t y = 16; y < 20; y++) CHECK(row(9, y, 10) == over);
+
+  // drawText() with bg: same box as the whole string at once
+  model.clearLog();
+  tft.drawText(40, 40, "AB", &font, R, K);
+  for(int16_t y = 36; y < 40; y++) CHECK(row(39, y, 10) == want);
+  CHECK(model.errors == 0);
+
+  // anti-aliased text: 'a', a character outside the font, then 'b'
+  tft.fillScreen(ST7735_WHITE);
+  tft.setAAColors(AA_FG, AA_BG);
+  CHECK(blend(0) == AA_BG);
+  CHECK(blend(15) == AA_FG);
+  tft.drawAAText(20, 60, "a?b", font4);
+  CHECK(row(20, 60, 12) == blends({ 0, 5, 10, 15, 0, 0, 0, 0, 1, 2, 3, 4 }));
+  CHECK(row(20, 61, 12) == blends({ 15, 10, 5, 0, 0, 0, 0, 0, 11, 12, 13, 14 }));
+  CHECK(row(19, 60, 1)[0] == ST7735_WHITE);
+  CHECK(row(32, 61, 1)[0] == ST7735_WHITE);
+  CHECK(row(20, 62, 1)[0] == ST7735_WHITE);
+
+  // 2 bit coverage is every fifth step of the same blend
+  tft.drawAAText(20, 70, "ab", font2);
+  CHECK(row(20, 70, 8) == blends({ 0, 5, 10, 15, 15, 15, 15, 15 }));
+  CHECK(row(20, 71, 8) == blends({ 15, 10, 5, 0, 0, 0, 0, 0 }));
+
+  // clipped at the left edge, glyph by glyph
+  tft.fillScreen(ST7735_WHITE);
+  tft.drawAAText(-2, 80, "ab", font4);
+  CHECK(row(0, 80, 6) == blends({ 10, 15, 1, 2, 3, 4 }));
+  tft.drawAAText(-2, 90, "ab", font2);
+  CHECK(row(0, 91, 6) == blends({ 5, 0, 0, 0, 0, 0 }));
+  CHECK(row(6, 91, 1)[0] == ST7735_WHITE);
+
+  // any other coverage depth is not drawn at all
+  static const uint8_t blank[8 * 8] = { 0 };
+  for(uint8_t bits = 0; bits <= 8; bits++) {
+    if((bits == 2) || (bits == 4)) continue;
+    ST7735_AAFont font = { 8, 8, bits, 'A', 1, blank };
+    model.clearLog();
+    tft.drawAAText(0, 0, "AB", font);
+    CHECK(model.log.empty());
+  }
+  CHECK(model.errors == 0);
+
+  return hostDone("test_text");
+}
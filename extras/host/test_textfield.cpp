@@ -0,0 +1,96 @@
+// ST7735_TextField: update() redraws only the glyph cells that changed,
+// one window per run of neighbouring changed cells, and nothing when the
+// text is the same; the panel always shows the whole text.
+
+#include "host.h"
+#include "ST7735_TextField.h"
+
+static Adafruit_ST7735 tft(TFT_CS, TFT_DC, TFT_RST);
+
+#define FX   8
+#define FY   50
+#define COLS 12
+
+static uint16_t setC = pgm_read_word(&fontCol[0]), clearC = pgm_read_word(&fontCol[1]);
+
+// the field as drawFont() would draw text padded to COLS
+static std::vector<uint16_t> expected(const char *text)
+{
+  std::vector<uint16_t> s;
+  size_t n = strlen(text);
+  for(int16_t y = 0; y < FONT_TILESZ; y++)
+    for(int16_t x = 0; x < COLS * FONT_TILESZ; x++) {
+      size_t col = x / FONT_TILESZ;
+      uint8_t tile = (uint8_t)(((col < n) ? text[col] : ' ') - 48);
+      if(tile > 50) tile = 11;
+      uint8_t bits = pgm_read_byte(&tileFont[tile * FONT_TILESZ + y]);
+      s.push_back((bits & (0x80 >> (x % FONT_TILESZ))) ? setC : clearC);
+    }
+  return s;
+}
+
+static std::vector<uint16_t> field(void)
+{
+  std::vector<uint16_t> s;
+  for(int16_t y = FY; y < FY + FONT_TILESZ; y++)
+    for(int16_t x = FX; x < FX + COLS * FONT_TILESZ; x++) s.push_back(model.at(x, y));
+  return s;
+}
+
+static uint32_t windows(void)
+{
+  uint32_t n = 0;
+  for(size_t i = 0; i < model.log.size(); i++) n += (model.log[i] == ST7735_RAMWR);
+  return n;
+}
+
+// update() to text: w windows and cells changed glyph cells go out
+static void step(ST7735_TextField &tf, const char *text, uint32_t w, uint32_t cells)
+{
+  model.clearLog();
+  tf.update(text);
+  if((windows() != w) || (model.pixels != cells * FONT_TILESZ * FONT_TILESZ))
+    printf("\"%s\": %u windows, %u pixels\n", text, (unsigned)windows(), (unsigned)model.pixels);
+  CHECK(windows() == w);
+  CHECK(model.pixels == cells * FONT_TILESZ * FONT_TILESZ);
+  CHECK(field() == expected(text));
+  CHECK(model.errors == 0);
+}
+
+int main()
+{
+  tft.initR(INITR_144GREENTAB);
+  model.ystart = 2;
+  tft.fillScreen(ST7735_RED);
+
+  ST7735_TextField tf(tft, FX, FY, COLS);
+  CHECK(tf.begin());
+
+  step(tf, "TEMP 21:5C", 1, COLS); // first update draws every cell
+  step(tf, "TEMP 21:5C", 0, 0);    // same text, nothing on the bus
+  CHECK(model.log.empty());
+  step(tf, "TEMP 21:6C", 1, 1);    // one character, one cell
+  step(tf, "TEMP 33:6C", 1, 2);    // two neighbours, one window
+  step(tf, "TEMP 34:7C", 2, 2);    // two apart, a window each
+  step(tf, "TEMP 45:8C", 2, 3);    // a run of two and one more
+  step(tf, "TIME 45:8C", 2, 2);
+  step(tf, "TIME 56;9C", 1, 4);    // a run of four
+  step(tf, "TIME", 1, 5);          // shorter text blanks the rest once
+  step(tf, "TIME", 0, 0);
+  step(tf, "TIME 12:00:00X", 1, 7); // longer text is cut off at COLS
+
+  // colours or invalidate() redraw every cell
+  setC = ST7735_YELLOW;
+  clearC = ST7735_BLUE;
+  tf.setColors(setC, clearC);
+  step(tf, "TIME 12:00:00X", 1, COLS);
+  tf.invalidate();
+  step(tf, "TIME 12:00:00X", 1, COLS);
+
+  // the field stays inside its cells
+  CHECK(model.at(FX - 1, FY) == ST7735_RED);
+  CHECK(model.at(FX + COLS * FONT_TILESZ, FY) == ST7735_RED);
+  CHECK(model.at(FX, FY + FONT_TILESZ) == ST7735_RED);
+
+  return hostDone("test_textfield");
+}
@@ -0,0 +1,179 @@
+// ST7735_Tilemap: render() redraws only the changed cells, a run of them
+// in as few windows as it can, and the sprite compositor puts the map and
+// the sprite on the panel pixel for pixel, whatever the width of the box.
+// From a raw and from an RLE sheet, in every rotation.
+
+#include "host.h"
+#include "assetc.h"
+#include "ST7735_Tilemap.h"
+
+static Adafruit_ST7735 tft(TFT_CS, TFT_DC, TFT_RST);
+
+#define TILES 4 // tiles in the sheet, in one row
+
+static uint16_t bgPal[16], spPal[16];
+
+// colour index of pixel tx, ty of a tile, busy enough that every column
+// and row of it differs from its neighbours
+static uint8_t sheetAt(uint8_t tile, uint8_t tx, uint8_t ty) { return (tile * 5 + tx + 2 * ty) & 15; }
+
+struct Sheet {
+  std::vector<uint8_t>  raw;  // byte per pixel, TILES * tw wide
+  std::vector<uint8_t>  rle;
+  std::vector<uint16_t> addr;
+  uint8_t tw, th;
+
+  Sheet(uint8_t w, uint8_t h) : tw(w), th(h) {
+    raw.resize(TILES * w * h);
+    addr.push_back((ST7735_RLE_V2 << 8) | TILES);
+    for(uint8_t t = 0; t < TILES; t++) {
+      std::vector<uint8_t> px;
+      for(uint8_t y = 0; y < h; y++)
+        for(uint8_t x = 0; x < w; x++) {
+          raw[y * TILES * w + t * w + x] = sheetAt(t, x, y);
+          px.push_back(sheetAt(t, x, y));
+        }
+      Encoded e = rleV2(px);
+      addr.push_back(rle.size());
+      rle.insert(rle.end(), e.data.begin(), e.data.end());
+    }
+  }
+};
+
+// 1bpp mask and byte per pixel colours of a w x h sprite
+struct Sprite {
+  std::vector<uint8_t> mask, index;
+  uint8_t w, h;
+
+  Sprite(uint8_t sw, uint8_t sh) : w(sw), h(sh) {
+    uint8_t maskW = (w + 7) / 8;
+    mask.assign(maskW * h, 0);
+    for(uint8_t y = 0; y < h; y++)
+      for(uint8_t x = 0; x < w; x++) {
+        if((x * 3 + y) % 5) mask[y * maskW + x / 8] |= 0x80 >> (x & 7);
+        index.push_back((x + y) & 15);
+      }
+  }
+  bool on(int16_t sx, int16_t sy) const { return mask[sy * ((w + 7) / 8) + sx / 8] & (0x80 >> (sx & 7)); }
+};
+
+// what the panel should show: the map at ox, oy over MAGENTA, and the
+// sprite at sx, sy where it is over the map
+static std::vector<uint16_t> expected(const Sheet &sh, ST7735_Tilemap &map, uint8_t cols, uint8_t rows,
+                                      int16_t ox, int16_t oy, const Sprite *sp, int16_t sx, int16_t sy)
+{
+  std::vector<uint16_t> s;
+  for(int16_t y = 0; y < tft.height(); y++)
+    for(int16_t x = 0; x < tft.width(); x++) {
+      int16_t mx = x - ox, my = y - oy;
+      if((mx < 0) || (my < 0) || (mx >= cols * sh.tw) || (my >= rows * sh.th)) {
+        s.push_back(ST7735_MAGENTA);
+        continue;
+      }
+      uint16_t c = bgPal[sheetAt(map.getTile(mx / sh.tw, my / sh.th), mx % sh.tw, my % sh.th)];
+      if(sp && (x >= sx) && (y >= sy) && (x < sx + sp->w) && (y < sy + sp->h) && sp->on(x - sx, y - sy))
+        c = spPal[sp->index[(y - sy) * sp->w + x - sx]];
+      s.push_back(c);
+    }
+  return s;
+}
+
+// render a cols x rows map at ox, oy, draw the sprite at sx, sy over it,
+// then restore the background under it
+static void compose(uint8_t tw, uint8_t cols, uint8_t rows, int16_t ox, int16_t oy,
+                    const Sprite &sp, int16_t sx, int16_t sy, bool rle)
+{
+  Sheet sh(tw, tw);
+  ST7735_Tilemap map(tft, cols, rows, tw, tw);
+  CHECK(map.begin());
+  if(rle) map.setSheetRLE(sh.rle.data(), sh.addr.data(), bgPal);
+  else    map.setSheet(sh.raw.data(), bgPal, TILES * tw);
+  for(uint8_t r = 0; r < rows; r++)
+    for(uint8_t c = 0; c < cols; c++) map.setTile(c, r, (r * 3 + c) % TILES);
+
+  tft.fillScreen(ST7735_MAGENTA);
+  map.render(ox, oy);
+  CHECK(model.screen(tft.width(), tft.height()) == expected(sh, map, cols, rows, ox, oy, NULL, 0, 0));
+
+  map.drawSprite(sx, sy, sp.w, sp.h, sp.mask.data(), sp.index.data(), spPal);
+  CHECK(model.screen(tft.width(), tft.height()) == expected(sh, map, cols, rows, ox, oy, &sp, sx, sy));
+
+  map.restore(sx, sy, sp.w, sp.h);
+  CHECK(model.screen(tft.width(), tft.height()) == expected(sh, map, cols, rows, ox, oy, NULL, 0, 0));
+  CHECK(model.errors == 0);
+}
+
+static uint32_t windows(void)
+{
+  uint32_t n = 0;
+  for(size_t i = 0; i < model.log.size(); i++) n += (model.log[i] == ST7735_RAMWR);
+  return n;
+}
+
+// changed cells merge into runs along a row, a run goes out in windows of
+// at most ST7735_MAX_TILE_RUN tiles, and cells that did not change put
+// nothing on the bus
+static void dirty(bool rle)
+{
+  Sheet sh(4, 4);
+  ST7735_Tilemap map(tft, 32, 32, 4, 4);
+  CHECK(map.begin());
+  if(rle) map.setSheetRLE(sh.rle.data(), sh.addr.data(), bgPal);
+  else    map.setSheet(sh.raw.data(), bgPal, TILES * 4);
+  map.fill(0);
+  tft.fillScreen(ST7735_MAGENTA);
+  model.clearLog();
+  map.render();
+  CHECK(windows() == 32 * 2); // a row of 32 tiles is 20 + 12
+
+  model.clearLog();
+  map.render();
+  CHECK(model.log.empty());
+  CHECK(model.transactions == 0);
+
+  map.setTile(3, 2, 1);
+  map.setTile(4, 2, 2);
+  map.setTile(5, 2, 3);
+  map.setTile(8, 2, 1);
+  for(uint8_t c = 2; c < 27; c++) map.setTile(c, 5, 1 + c % 3);
+  map.setTile(31, 31, 2);
+  map.setTile(7, 9, 0); // unchanged
+  model.clearLog();
+  map.render();
+  CHECK(windows() == 2 + 2 + 1); // 3..5 and 8, 2..21 and 22..26, 31
+  CHECK(model.screen(128, 128) == expected(sh, map, 32, 32, 0, 0, NULL, 0, 0));
+  CHECK(model.errors == 0);
+
+  model.clearLog();
+  map.render();
+  CHECK(model.log.empty());
+}
+
+int main()
+{
+  for(uint8_t i = 0; i < 16; i++) {
+    bgPal[i] = (i << 11) | (i << 1);
+    spPal[i] = (i << 6) | 0x001F;
+  }
+
+  // 4px tiles: a 90px sprite hanging off the left edge covers 22 columns
+  tft.initR(INITR_144GREENTAB);
+  model.ystart = 2;
+  Sprite wide(90, 6);
+  for(uint8_t rot = 0; rot < 4; rot++) {
+    tft.setRotation(rot);
+    dirty(false);
+    dirty(true);
+    compose(4, 32, 32, 0, 0, wide, -5, 10, false);
+    compose(4, 32, 32, 0, 0, wide, -5, 10, true);
+  }
+
+  // 6px tiles: a screen-wide box over a map that is not on a tile
+  // boundary covers 22 columns
+  tft.setRotation(1);
+  Sprite band(128, 8);
+  compose(6, 22, 22, -3, 0, band, 0, 12, false);
+  compose(6, 22, 22, -3, 0, band, 0, 12, true);
+
+  return hostDone("test_tilemap");
+}